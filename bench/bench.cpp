@@ -26,12 +26,27 @@
 #include <boost/json.hpp>
 #include <boost/json/basic_parser_impl.hpp>
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <iostream>
 #include <memory>
 #include <cstdio>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <thread>
 #include <vector>
 
+#if defined(__linux__)
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+# define BOOST_JSON_BENCH_HAS_PERF
+#endif
+
+#include "generate.hpp"
 #include "test_suite.hpp"
 
 /*  References
@@ -71,12 +86,23 @@ string_view arch = "x64" SSE2_ARCH_SUFFIX;
 
 struct file_item
 {
-    string_view name;
+    std::string name;
     std::string text;
 };
 
 using file_list = std::vector<file_item>;
 
+// Allows the deep documents made by -g
+parse_options
+make_parse_options()
+{
+    parse_options opt;
+    opt.max_depth = 10000;
+    return opt;
+}
+
+parse_options const s_parse_options = make_parse_options();
+
 class any_impl
 {
 public:
@@ -105,13 +131,218 @@ load_file(char const* path)
     return s;
 }
 
+//----------------------------------------------------------
+
+// Hardware and software event counters for the
+// calling thread, read through perf_event_open.
+// Events which cannot be opened, because the
+// platform or the permissions do not allow it,
+// read as -1.
+class perf_counters
+{
+public:
+    enum id
+    {
+        cycles,
+        instructions,
+        branch_misses,
+        l1d_misses,
+        llc_misses,
+        page_faults,
+        count
+    };
+
+    using values = std::array<double, count>;
+
+    perf_counters()
+    {
+        fd_.fill(-1);
+#ifdef BOOST_JSON_BENCH_HAS_PERF
+        auto const cache = [](unsigned long long c)
+        {
+            return c |
+                (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        };
+        open(cycles, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_CPU_CYCLES);
+        open(instructions, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_INSTRUCTIONS);
+        open(branch_misses, PERF_TYPE_HARDWARE,
+            PERF_COUNT_HW_BRANCH_MISSES);
+        open(l1d_misses, PERF_TYPE_HW_CACHE,
+            cache(PERF_COUNT_HW_CACHE_L1D));
+        open(llc_misses, PERF_TYPE_HW_CACHE,
+            cache(PERF_COUNT_HW_CACHE_LL));
+        open(page_faults, PERF_TYPE_SOFTWARE,
+            PERF_COUNT_SW_PAGE_FAULTS);
+#endif
+    }
+
+    perf_counters(perf_counters const&) = delete;
+    perf_counters& operator=(perf_counters const&) = delete;
+
+    ~perf_counters()
+    {
+#ifdef BOOST_JSON_BENCH_HAS_PERF
+        for(int fd : fd_)
+            if(fd != -1)
+                ::close(fd);
+#endif
+    }
+
+    bool
+    available() const noexcept
+    {
+        return std::any_of(fd_.begin(), fd_.end(),
+            [](int fd) { return fd != -1; });
+    }
+
+    void
+    start() noexcept
+    {
+#ifdef BOOST_JSON_BENCH_HAS_PERF
+        for(int fd : fd_)
+        {
+            if(fd == -1)
+                continue;
+            ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Returns the counts since start, scaled up
+    // when the kernel had to multiplex the events.
+    values
+    stop() noexcept
+    {
+        values v;
+        v.fill(-1);
+#ifdef BOOST_JSON_BENCH_HAS_PERF
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            if(fd_[i] == -1)
+                continue;
+            ::ioctl(fd_[i], PERF_EVENT_IOC_DISABLE, 0);
+            // value, time enabled, time running
+            std::uint64_t r[3];
+            if(::read(fd_[i], r, sizeof(r)) !=
+                    sizeof(r) || r[2] == 0)
+                continue;
+            v[i] = static_cast<double>(r[0]) *
+                static_cast<double>(r[1]) /
+                static_cast<double>(r[2]);
+        }
+#endif
+        return v;
+    }
+
+private:
+    std::array<int, count> fd_;
+
+#ifdef BOOST_JSON_BENCH_HAS_PERF
+    void
+    open(
+        id i,
+        std::uint32_t type,
+        std::uint64_t config) noexcept
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = type;
+        attr.config = config;
+        attr.disabled = 1;
+        attr.exclude_hv = 1;
+        attr.read_format =
+            PERF_FORMAT_TOTAL_TIME_ENABLED |
+            PERF_FORMAT_TOTAL_TIME_RUNNING;
+        // count the kernel too when permitted,
+        // page faults are only seen there
+        for(int user_only = 0; user_only < 2; ++user_only)
+        {
+            attr.exclude_kernel = user_only;
+            long const fd = ::syscall(
+                __NR_perf_event_open, &attr, 0, -1, -1, 0);
+            if(fd != -1)
+            {
+                fd_[i] = static_cast<int>(fd);
+                return;
+            }
+        }
+    }
+#endif
+};
+
+bool s_counters = false;
+
 struct sample
 {
     std::size_t calls;
     std::size_t millis;
     std::size_t mbs;
+    perf_counters::values counters;
 };
 
+// Every measurement, written as JSON with -o
+array s_results;
+
+// Appends the throughput of each trial in MB/s,
+// with their median and relative spread.
+void
+record(
+    string_view verb,
+    string_view file,
+    string_view impl,
+    std::size_t threads,
+    std::vector<double> mbs)
+{
+    std::sort(mbs.begin(), mbs.end());
+    auto const n = mbs.size();
+    double const median = n % 2 ?
+        mbs[n / 2] : (mbs[n / 2 - 1] + mbs[n / 2]) / 2;
+    object r;
+    r["verb"] = verb;
+    r["file"] = file;
+    r["toolset"] = toolset;
+    r["arch"] = arch;
+    r["impl"] = impl;
+    r["threads"] = threads;
+    r["trials"] = array(mbs.begin(), mbs.end());
+    r["median"] = median;
+    r["spread"] = (mbs.back() - mbs.front()) / median;
+    s_results.emplace_back(std::move(r));
+}
+
+// Formats the counters per byte of input
+std::string
+format_counters(
+    perf_counters::values const& v,
+    double bytes)
+{
+    auto const put = [](std::string& s,
+        double x, double div, double mul)
+    {
+        char buf[32];
+        if(x < 0 || div <= 0)
+            std::snprintf(buf, sizeof(buf), ",-");
+        else
+            std::snprintf(buf, sizeof(buf),
+                ",%.3f", mul * x / div);
+        s += buf;
+    };
+    std::string s;
+    put(s, v[perf_counters::cycles], bytes, 1);
+    put(s, v[perf_counters::instructions],
+        v[perf_counters::cycles], 1);
+    put(s, v[perf_counters::branch_misses], bytes, 1024);
+    put(s, v[perf_counters::l1d_misses], bytes, 1024);
+    put(s, v[perf_counters::llc_misses], bytes, 1024);
+    put(s, v[perf_counters::page_faults], bytes, 1024);
+    return s;
+}
+
 // Returns the number of invocations per second
 template<
     class Rep,
@@ -138,7 +369,7 @@ run_for(
     return { n, static_cast<std::size_t>(
         std::chrono::duration_cast<
             std::chrono::milliseconds>(
-                elapsed).count()), 0 };
+                elapsed).count()), 0, {} };
 }
 
 void
@@ -148,6 +379,16 @@ bench(
     impl_list const& vi, std::size_t Trials)
 {
     std::vector<sample> trial;
+    std::unique_ptr<perf_counters> pc;
+    if(s_counters)
+    {
+        pc.reset(new perf_counters);
+        if(! pc->available())
+        {
+            dout << "Performance counters are not available\n";
+            pc.reset();
+        }
+    }
     for(unsigned i = 0; i < vf.size(); ++i)
     {
         for(unsigned j = 0; j < vi.size(); ++j)
@@ -156,6 +397,8 @@ bench(
             std::size_t repeat = 1000;
             for(unsigned k = 0; k < Trials; ++k)
             {
+                if(pc)
+                    pc->start();
                 auto result = run_for(
                     std::chrono::seconds(5),
                     [&]
@@ -169,6 +412,8 @@ bench(
                                 vf[i].text,
                                 repeat);
                     });
+                if(pc)
+                    result.counters = pc->stop();
                 result.calls *= repeat;
                 result.mbs = static_cast<
                     std::size_t>(( 0.5 + 1000.0 *
@@ -181,13 +426,28 @@ bench(
                     vi[j]->name() << "," <<
                     result.calls << "," <<
                     result.millis << "," <<
-                    result.mbs <<
-                    "\n";
+                    result.mbs;
+                if(pc)
+                    dout << format_counters(
+                        result.counters,
+                        static_cast<double>(result.calls) *
+                            vf[i].text.size());
+                dout << "\n";
                 trial.push_back(result);
                 // adjust repeat to avoid overlong tests
                 repeat = 250 * result.calls / result.millis;
             }
 
+            {
+                std::vector<double> v;
+                for(auto const& t : trial)
+                    v.push_back(1000.0 * t.calls *
+                        vf[i].text.size() /
+                        t.millis / 1024 / 1024);
+                record(verb, vf[i].name,
+                    vi[j]->name(), 1, std::move(v));
+            }
+
             // clean up the samples
             std::sort(
                 trial.begin(),
@@ -239,8 +499,132 @@ bench(
                 verb << " " << vf[i].name << "," <<
                 toolset << " " << arch << "," <<
                 vi[j]->name() << "," <<
-                mbs <<
-                "\n";
+                mbs;
+            if(pc)
+            {
+                // totals over the samples kept
+                perf_counters::values sum;
+                sum.fill(0);
+                for(auto const& t : trial)
+                    for(std::size_t c = 0; c < sum.size(); ++c)
+                        sum[c] = (sum[c] < 0 || t.counters[c] < 0) ?
+                            -1 : sum[c] + t.counters[c];
+                strout << format_counters(sum,
+                    static_cast<double>(calls) *
+                        vf[i].text.size());
+            }
+            strout << "\n";
+        }
+    }
+}
+
+//----------------------------------------------------------
+
+// Runs each implementation on 1, 2, 4, ... up to
+// `threads` threads at once, every thread working on
+// its own copy of the file, and reports aggregate
+// throughput and the efficiency relative to one
+// thread.
+void
+bench_threads(
+    string_view verb,
+    file_list const& vf,
+    impl_list const& vi,
+    std::size_t Trials,
+    std::size_t threads)
+{
+    std::vector<std::size_t> counts;
+    for(std::size_t t = 1; t < threads; t *= 2)
+        counts.push_back(t);
+    counts.push_back(threads);
+
+    for(unsigned i = 0; i < vf.size(); ++i)
+    {
+        for(unsigned j = 0; j < vi.size(); ++j)
+        {
+            auto const call = [&](
+                string_view text, std::size_t repeat)
+            {
+                if(verb == "Parse")
+                    vi[j]->parse(text, repeat);
+                else
+                    vi[j]->serialize(text, repeat);
+            };
+            // As in bench(), each call repeats the
+            // operation, so that the parse done by
+            // serialize() before its loop is spread
+            // over many serializations. Double the
+            // count until one call takes 250ms.
+            std::size_t repeat = 1;
+            while(run_for(std::chrono::seconds(0),
+                [&]
+                {
+                    call(vf[i].text, repeat);
+                }).millis < 250)
+                repeat *= 2;
+            double single = 0;
+            for(auto const t : counts)
+            {
+                std::vector<double> trial;
+                for(unsigned k = 0; k < Trials; ++k)
+                {
+                    std::vector<sample> results(t);
+                    std::vector<std::thread> pool;
+                    std::atomic<std::size_t> ready(0);
+                    for(std::size_t n = 0; n < t; ++n)
+                    {
+                        pool.emplace_back(
+                        [&, n]
+                        {
+                            // copy on this thread so the
+                            // text is local to it
+                            std::string const text(vf[i].text);
+                            ++ready;
+                            while(ready.load() < t)
+                                std::this_thread::yield();
+                            results[n] = run_for(
+                                std::chrono::seconds(2),
+                                [&]
+                                {
+                                    call(text, repeat);
+                                });
+                        });
+                    }
+                    for(auto& th : pool)
+                        th.join();
+                    double mbs = 0;
+                    for(auto const& r : results)
+                        mbs += 1000.0 * r.calls * repeat *
+                            vf[i].text.size() /
+                            r.millis / 1024 / 1024;
+                    dout <<
+                        verb << " " << vf[i].name << "," <<
+                        toolset << " " << arch << "," <<
+                        vi[j]->name() << "," <<
+                        t << " threads," <<
+                        static_cast<std::size_t>(mbs + 0.5) <<
+                        "\n";
+                    trial.push_back(mbs);
+                }
+                // distinct from the rows of bench(),
+                // which also run on one thread
+                record(std::string(verb) + " (threads)",
+                    vf[i].name, vi[j]->name(), t, trial);
+                // median of the trials
+                std::sort(trial.begin(), trial.end());
+                double const mbs = trial[trial.size() / 2];
+                if(t == 1)
+                    single = mbs;
+                strout <<
+                    verb << " " << vf[i].name << "," <<
+                    toolset << " " << arch << "," <<
+                    vi[j]->name() << "," <<
+                    t << "," <<
+                    static_cast<std::size_t>(mbs + 0.5) << "," <<
+                    static_cast<std::size_t>(0.5 + 100 *
+                        mbs / (single * t)) << "%" <<
+                    "\n";
+            }
         }
     }
 }
@@ -271,7 +655,7 @@ public:
         string_view s,
         std::size_t repeat) const override
     {
-        stream_parser p;
+        stream_parser p(storage_ptr(), s_parse_options);
         while(repeat--)
         {
             p.reset();
@@ -289,7 +673,7 @@ public:
         string_view s,
         std::size_t repeat) const override
     {
-        auto jv = json::parse(s);
+        auto jv = json::parse(s, {}, s_parse_options);
         serializer sr;
         string out;
         out.reserve(512);
@@ -338,7 +722,7 @@ public:
         string_view s,
         std::size_t repeat) const override
     {
-        stream_parser p;
+        stream_parser p(storage_ptr(), s_parse_options);
         while(repeat--)
         {
             monotonic_resource mr;
@@ -358,7 +742,105 @@ public:
         std::size_t repeat) const override
     {
         monotonic_resource mr;
-        auto jv = json::parse(s, &mr);
+        auto jv = json::parse(s, &mr, s_parse_options);
+        serializer sr;
+        string out;
+        out.reserve(512);
+        while(repeat--)
+        {
+            sr.reset(&jv);
+            out.clear();
+            for(;;)
+            {
+                out.grow(sr.read(
+                    out.end(),
+                    out.capacity() -
+                        out.size()).size());
+                if(sr.done())
+                    break;
+                out.reserve(
+                    out.capacity() + 1);
+            }
+        }
+    }
+};
+
+//----------------------------------------------------------
+
+// Every value shares one reference counted resource,
+// so threads contend on the count.
+class boost_shared_impl : public any_impl
+{
+    class new_resource : public memory_resource
+    {
+        void*
+        do_allocate(
+            std::size_t n,
+            std::size_t) override
+        {
+            return ::operator new(n);
+        }
+
+        void
+        do_deallocate(
+            void* p,
+            std::size_t,
+            std::size_t) override
+        {
+            ::operator delete(p);
+        }
+
+        bool
+        do_is_equal(
+            memory_resource const& mr) const noexcept override
+        {
+            return this == &mr;
+        }
+    };
+
+    std::string name_;
+    storage_ptr sp_;
+
+public:
+    boost_shared_impl(
+        std::string const& branch)
+        : sp_(make_shared_resource<new_resource>())
+    {
+        name_ = "boost (shared)";
+        if(! branch.empty())
+            name_ += " " + branch;
+    }
+
+    string_view
+    name() const noexcept override
+    {
+        return name_;
+    }
+
+    void
+    parse(
+        string_view s,
+        std::size_t repeat) const override
+    {
+        stream_parser p(storage_ptr(), s_parse_options);
+        while(repeat--)
+        {
+            p.reset(sp_);
+            error_code ec;
+            p.write(s.data(), s.size(), ec);
+            if(! ec)
+                p.finish(ec);
+            if(! ec)
+                auto jv = p.release();
+        }
+    }
+
+    void
+    serialize(
+        string_view s,
+        std::size_t repeat) const override
+    {
+        auto jv = json::parse(s, sp_, s_parse_options);
         serializer sr;
         string out;
         out.reserve(512);
@@ -417,7 +899,7 @@ class boost_null_impl : public any_impl
         basic_parser<handler> p_;
 
         null_parser()
-            : p_(json::parse_options())
+            : p_(s_parse_options)
         {
         }
 
@@ -482,6 +964,98 @@ public:
 
 //----------------------------------------------------------
 
+// Returns the text split into segments whose sizes are
+// pseudo-random in [1, max_size], such as a network
+// stack might deliver, so that most tokens cross a
+// segment boundary when max_size is small.
+std::vector<string_view>
+split_text(
+    string_view s,
+    std::size_t max_size)
+{
+    std::vector<string_view> v;
+    std::uint32_t r = 2166136261u;
+    while(! s.empty())
+    {
+        r = r * 1664525u + 1013904223u;
+        auto const n = (std::min)(s.size(),
+            1 + (r >> 8) % max_size);
+        v.push_back(s.substr(0, n));
+        s.remove_prefix(n);
+    }
+    return v;
+}
+
+class boost_split_impl : public any_impl
+{
+    std::string name_;
+    std::size_t max_size_;
+    bool gather_;
+
+public:
+    boost_split_impl(
+        std::string const& branch,
+        std::size_t max_size,
+        bool gather)
+        : max_size_(max_size)
+        , gather_(gather)
+    {
+        name_ = gather ?
+            "boost (gather " : "boost (split ";
+        name_ += std::to_string(max_size) + ")";
+        if(! branch.empty())
+            name_ += " " + branch;
+    }
+
+    string_view
+    name() const noexcept override
+    {
+        return name_;
+    }
+
+    void
+    parse(
+        string_view s,
+        std::size_t repeat) const override
+    {
+        auto const v = split_text(s, max_size_);
+        stream_parser p(storage_ptr(), s_parse_options);
+        while(repeat--)
+        {
+            monotonic_resource mr;
+            p.reset(&mr);
+            error_code ec;
+            if(gather_)
+            {
+                // one call for the whole chain
+                p.write(v, ec);
+            }
+            else
+            {
+                // one call per segment
+                for(auto const& b : v)
+                {
+                    p.write(b, ec);
+                    if(ec)
+                        break;
+                }
+            }
+            if(! ec)
+                p.finish(ec);
+            if(! ec)
+                auto jv = p.release();
+        }
+    }
+
+    void
+    serialize(
+        string_view, std::size_t) const override
+    {
+    }
+};
+
+//----------------------------------------------------------
+
 struct rapidjson_crt_impl : public any_impl
 {
     string_view
@@ -602,6 +1176,11 @@ std::string s_tests = "ps";
 std::string s_impls = "bdrcn";
 std::size_t s_trials = 6;
 std::string s_branch = "";
+std::string s_output = "";
+std::vector<std::string> s_generate;
+std::size_t s_split = 16;
+std::size_t s_threads =
+    (std::max)(1u, std::thread::hardware_concurrency());
 
 static bool parse_option( char const * s )
 {
@@ -649,6 +1228,55 @@ static bool parse_option( char const * s )
     case 'b':
         s_branch = s;
         break;
+
+    case 'c':
+
+        s_counters = std::atoi( s ) != 0;
+        break;
+
+    case 'o':
+
+        s_output = s;
+        break;
+
+    case 'g':
+
+        s_generate.push_back( s );
+        break;
+
+    case 'j':
+
+        {
+            int k = std::atoi( s );
+
+            if( k > 0 )
+            {
+                s_threads = k;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        break;
+
+    case 's':
+
+        {
+            int k = std::atoi( s );
+
+            if( k > 0 )
+            {
+                s_split = k;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        break;
     }
 
     return true;
@@ -673,6 +1301,21 @@ static bool add_impl( impl_list & vi, char impl )
         vi.emplace_back(new boost_null_impl(s_branch));
         break;
 
+    case 'h':
+
+        vi.emplace_back(new boost_shared_impl(s_branch));
+        break;
+
+    case 'x':
+
+        vi.emplace_back(new boost_split_impl(s_branch, s_split, false));
+        break;
+
+    case 'g':
+
+        vi.emplace_back(new boost_split_impl(s_branch, s_split, true));
+        break;
+
     case 'r':
 
         vi.emplace_back(new rapidjson_memory_impl);
@@ -711,6 +1354,16 @@ static bool do_test( file_list const & vf, impl_list const & vi, char test )
         bench("Serialize", vf, vi, s_trials);
         break;
 
+    case 'P':
+
+        bench_threads("Parse", vf, vi, s_trials, s_threads);
+        break;
+
+    case 'S':
+
+        bench_threads("Serialize", vf, vi, s_trials, s_threads);
+        break;
+
     default:
 
         std::cerr << "Unknown test type: '" << test << "'\n";
@@ -720,6 +1373,88 @@ static bool do_test( file_list const & vf, impl_list const & vi, char test )
     return true;
 }
 
+// Appends the documents described by a spec of the
+// form <shape>[:<name>=<value>[,<value>...]]..., one
+// for each combination of the listed values.
+static bool add_generated( file_list & vf, std::string const & spec )
+{
+    std::vector<std::string> parts;
+    std::string::size_type pos = 0;
+    for( ;; )
+    {
+        auto const colon = spec.find( ':', pos );
+        parts.push_back( spec.substr( pos, colon - pos ) );
+        if( colon == std::string::npos )
+            break;
+        pos = colon + 1;
+    }
+
+    std::string const shape = parts[0];
+    if( shape == "ndjson" )
+    {
+        // bench parses one document per file
+        return false;
+    }
+
+    std::vector<std::pair<std::string, std::vector<double>>> axes;
+    for( std::size_t i = 1; i < parts.size(); ++i )
+    {
+        auto const eq = parts[i].find( '=' );
+        if( eq == std::string::npos )
+            return false;
+        std::vector<double> values;
+        char const * p = parts[i].c_str() + eq + 1;
+        for( ;; )
+        {
+            char* end;
+            values.push_back( std::strtod( p, &end ) );
+            if( end == p )
+                return false;
+            if( *end != ',' )
+                break;
+            p = end + 1;
+        }
+        axes.emplace_back( parts[i].substr( 0, eq ), std::move( values ) );
+    }
+
+    // odometer over the values of every axis
+    std::vector<std::size_t> at( axes.size() );
+    for( ;; )
+    {
+        synthetic::param_map params;
+        std::string name = shape;
+        for( std::size_t i = 0; i < axes.size(); ++i )
+        {
+            double const x = axes[i].second[at[i]];
+            params[axes[i].first] = x;
+            std::ostringstream os;
+            os << " " << axes[i].first << "=" << x;
+            name += os.str();
+        }
+        try
+        {
+            vf.push_back( file_item{ name,
+                synthetic::generator( 1 )( shape, params ) } );
+        }
+        catch( std::invalid_argument const& )
+        {
+            return false;
+        }
+
+        std::size_t i = 0;
+        for( ; i < axes.size(); ++i )
+        {
+            if( ++at[i] < axes[i].second.size() )
+                break;
+            at[i] = 0;
+        }
+        if( i == axes.size() )
+            break;
+    }
+
+    return true;
+}
+
 int
 main(
     int const argc,
@@ -730,18 +1465,33 @@ main(
         std::cerr <<
             "Usage: bench [options...] <file>...\n"
             "\n"
-            "Options:  -t:[p][s]            Test parsing, serialization or both\n"
+            "Options:  -t:[p][s][P][S]      Test parsing, serialization or both\n"
 			"                                 (default both)\n"
+            "                                 (P, S: on 1 up to -j threads)\n"
             "          -i:[b][d][r][c][n]   Test the specified implementations\n"
             "                                 (b: Boost.JSON, pool storage)\n"
             "                                 (d: Boost.JSON, default storage)\n"
             "                                 (u: Boost.JSON, null parser)\n"
+            "                                 (h: Boost.JSON, shared counted storage)\n"
+            "                                 (x: Boost.JSON, one write per segment)\n"
+            "                                 (g: Boost.JSON, buffer sequence write)\n"
             "                                 (r: RapidJSON, memory storage)\n"
             "                                 (c: RapidJSON, CRT storage)\n"
             "                                 (n: nlohmann/json)\n"
 			"                                 (default all)\n"
             "          -n:<number>          Number of trials (default 6)\n"
             "          -b:<branch>          Branch label for boost implementations\n"
+            "          -s:<number>          Largest segment size for x and g (default 16)\n"
+            "          -j:<number>          Most threads for P and S (default all cores)\n"
+            "          -g:<shape>[:<name>=<value>[,<value>...]]...\n"
+            "                               Add generated documents, one for each\n"
+            "                                 combination of values, see generate.hpp\n"
+            "                                 (for example -g:wide:keys=10,1000,100000)\n"
+            "          -o:<file>            Write every sample to <file> as JSON, for\n"
+            "                                 comparison with bench_compare\n"
+            "          -c:1                 Collect performance counters for p and s, which\n"
+            "                                 adds cycles/byte, IPC, and branch, L1D, LLC\n"
+            "                                 misses and page faults per KB to each line\n"
         ;
 
         return 4;
@@ -766,6 +1516,15 @@ main(
         }
     }
 
+    for( auto const & spec : s_generate )
+    {
+        if( !add_generated( vf, spec ) )
+        {
+            std::cerr << "Incorrect shape: '" << spec << "'\n";
+            return 4;
+        }
+    }
+
     try
     {
 /*
@@ -784,6 +1543,25 @@ main(
         }
 
         dout << "\n" << strout.str();
+
+        if( !s_output.empty() )
+        {
+            object out;
+            out["toolset"] = toolset;
+            out["arch"] = arch;
+            out["branch"] = s_branch;
+            out["results"] = std::move( s_results );
+
+            FILE* f = fopen( s_output.c_str(), "wb" );
+            if( !f )
+            {
+                std::cerr << "Cannot open '" << s_output << "'\n";
+                return 1;
+            }
+            std::string const text = serialize( out );
+            fwrite( text.data(), 1, text.size(), f );
+            fclose( f );
+        }
     }
     catch(system_error const& se)
     {
@@ -0,0 +1,303 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+/*  Throughput of stream_parser when the input arrives in pieces
+
+    Each file is parsed whole, then fed to the parser in
+    chunks of fixed sizes and in randomly sized chunks.
+    Every chunk boundary which falls inside a token makes
+    the parser suspend and later resume, and splits
+    strings and keys into several on_*_part calls, so the
+    ratio to the whole buffer throughput shows what
+    incremental input costs for each size of read.
+*/
+
+#include <boost/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace json {
+
+using clock_type = std::chrono::steady_clock;
+
+std::size_t s_trials = 3;
+std::size_t s_millis = 1000;
+
+// Values computed by the parses are accumulated
+// here so that the optimizer cannot discard them.
+std::size_t volatile sink;
+
+struct document
+{
+    std::string name;
+    std::string text;
+};
+
+// How the input is cut into chunks
+struct split
+{
+    std::string name;
+    std::vector<string_view> chunks;
+};
+
+std::vector<string_view>
+fixed_chunks(
+    string_view s,
+    std::size_t size)
+{
+    std::vector<string_view> v;
+    while(! s.empty())
+    {
+        auto const n = (std::min)(s.size(), size);
+        v.push_back(s.substr(0, n));
+        s.remove_prefix(n);
+    }
+    return v;
+}
+
+// Chunk sizes are drawn uniformly from 1 to
+// `max_size`, the same way for every run.
+std::vector<string_view>
+random_chunks(
+    string_view s,
+    std::size_t max_size)
+{
+    std::mt19937 rng(static_cast<unsigned>(max_size));
+    std::uniform_int_distribution<
+        std::size_t> dist(1, max_size);
+    std::vector<string_view> v;
+    while(! s.empty())
+    {
+        auto const n = (std::min)(s.size(), dist(rng));
+        v.push_back(s.substr(0, n));
+        s.remove_prefix(n);
+    }
+    return v;
+}
+
+std::vector<split>
+make_splits(string_view s)
+{
+    std::vector<split> v;
+    v.push_back({ "whole", { s } });
+    // 1500 and 16384 are typical sizes of socket
+    // reads, over ethernet and through TLS records
+    for(std::size_t n : {
+        1, 4, 16, 64, 256, 1024, 1500,
+        4096, 16384, 65536 })
+        v.push_back({ std::to_string(n),
+            fixed_chunks(s, n) });
+    for(std::size_t n : { 64, 1500, 16384 })
+        v.push_back({ "random 1-" + std::to_string(n),
+            random_chunks(s, n) });
+    return v;
+}
+
+parse_options
+make_parse_options()
+{
+    parse_options opt;
+    opt.max_depth = 10000;
+    return opt;
+}
+
+// Returns the number of bytes parsed per second,
+// the best of several trials.
+double
+measure(
+    stream_parser& p,
+    std::vector<string_view> const& chunks,
+    std::size_t size)
+{
+    double best = 0;
+    for(std::size_t k = 0; k < s_trials; ++k)
+    {
+        std::size_t n = 0;
+        auto const interval =
+            std::chrono::milliseconds(s_millis);
+        auto const t0 = clock_type::now();
+        auto elapsed = clock_type::now() - t0;
+        do
+        {
+            monotonic_resource mr;
+            p.reset(&mr);
+            for(auto const& c : chunks)
+                p.write(c);
+            p.finish();
+            auto const jv = p.release();
+            sink = sink + (jv.is_structured() ? 1 : 0);
+            ++n;
+            elapsed = clock_type::now() - t0;
+        }
+        while(elapsed < interval);
+        auto const seconds = std::chrono::duration<
+            double>(elapsed).count();
+        best = (std::max)(best,
+            static_cast<double>(n) * size / seconds);
+    }
+    return best;
+}
+
+void
+bench(document const& d)
+{
+    stream_parser p(storage_ptr(), make_parse_options());
+    auto const splits = make_splits(d.text);
+    // warm up the caches and allocator
+    for(int i = 0; i < 10; ++i)
+    {
+        p.reset();
+        p.write(d.text);
+        p.finish();
+        sink = sink + p.release().is_structured();
+    }
+    double whole = 0;
+    for(auto const& sp : splits)
+    {
+        auto const bps = measure(
+            p, sp.chunks, d.text.size());
+        if(whole == 0)
+            whole = bps;
+        std::printf("%-24s %-18s %10zu %10.1f %7.1f%%\n",
+            d.name.c_str(), sp.name.c_str(),
+            sp.chunks.size(), bps / 1024 / 1024,
+            100 * bps / whole);
+        std::fflush(stdout);
+    }
+}
+
+} // json
+} // boost
+
+//
+
+using namespace boost::json;
+
+std::string
+load_file(char const* path)
+{
+    std::string s;
+    FILE* f = fopen(path, "rb");
+    if(! f)
+        return s;
+    char buf[4096];
+    std::size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        s.append(buf, n);
+    fclose(f);
+    return s;
+}
+
+static bool parse_option( char const * s )
+{
+    if( *s == 0 )
+    {
+        return false;
+    }
+
+    char opt = *s++;
+
+    if( *s++ != ':' )
+    {
+        return false;
+    }
+
+    int k = std::atoi( s );
+
+    if( k <= 0 )
+    {
+        return false;
+    }
+
+    switch( opt )
+    {
+    case 'n':
+
+        s_trials = k;
+        break;
+
+    case 'm':
+
+        s_millis = k;
+        break;
+
+    default:
+
+        return false;
+    }
+
+    return true;
+}
+
+int
+main(
+    int const argc,
+    char const* const* const argv)
+{
+    std::vector<document> vd;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        char const * s = argv[ i ];
+
+        if( *s == '-' )
+        {
+            if( !parse_option( s+1 ) )
+            {
+                vd.clear();
+                break;
+            }
+        }
+        else
+        {
+            vd.push_back( { s, load_file( s ) } );
+        }
+    }
+
+    if( vd.empty() )
+    {
+        std::fprintf( stderr,
+            "Usage: bench_chunked [options...] <file...>\n"
+            "\n"
+            "Options:  -n:<number>          Trials per chunk size, the best\n"
+            "                                 is reported (default 3)\n"
+            "          -m:<number>          Milliseconds per trial (default 1000)\n"
+            "\n"
+            "Each file is parsed whole, in chunks of 1 byte to 64KB,\n"
+            "and in randomly sized chunks.\n" );
+        return 4;
+    }
+
+    std::printf( "%-24s %-18s %10s %10s %8s\n",
+        "file", "chunks", "count", "MB/s", "whole" );
+
+    try
+    {
+        for( auto const& d : vd )
+        {
+            bench( d );
+        }
+    }
+    catch( std::exception const& e )
+    {
+        std::fprintf( stderr, "%s\n", e.what() );
+        return 1;
+    }
+
+    return 0;
+}
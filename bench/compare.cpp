@@ -0,0 +1,303 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+/*  Compares two result files written by bench -o
+
+    A measurement is reported as slower when its median
+    throughput dropped by more than the threshold, and a
+    one-sided Mann-Whitney U test on the trials rejects
+    the hypothesis that both runs come from the same
+    distribution. The exit status is 1 when anything is
+    slower, so that the tool can gate a build.
+*/
+
+#include <boost/json.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace json {
+
+double s_alpha = 0.05;
+double s_threshold = 3;
+
+struct entry
+{
+    std::vector<double> trials;
+    double median;
+};
+
+using entry_map = std::map<std::string, entry>;
+
+// Returns the measurements in a result file,
+// keyed by verb, file, implementation and threads.
+entry_map
+load(char const* path)
+{
+    value const jv = parse_file(path);
+    entry_map m;
+    for(auto const& r : jv.at("results").as_array())
+    {
+        auto const& o = r.as_object();
+        auto const str = [&o](string_view name)
+        {
+            auto const& s = o.at(name).as_string();
+            return std::string(s.data(), s.size());
+        };
+        std::string key = str("verb") + " " +
+            str("file") + "," + str("impl");
+        auto const threads = o.at("threads").to_number<std::size_t>();
+        if(threads != 1)
+            key += "," + std::to_string(threads) + " threads";
+        entry e;
+        for(auto const& t : o.at("trials").as_array())
+            e.trials.push_back(t.to_number<double>());
+        e.median = o.at("median").to_number<double>();
+        // keeping either would silently
+        // compare the wrong measurement
+        if(! m.emplace(key, std::move(e)).second)
+            throw std::runtime_error(
+                std::string(path) +
+                ": duplicate measurement " + key);
+    }
+    return m;
+}
+
+// Returns the statistic U, the number of pairs
+// in which the sample from `x` is greater, with
+// ties counting one half.
+double
+mann_whitney_u(
+    std::vector<double> const& x,
+    std::vector<double> const& y)
+{
+    double u = 0;
+    for(double a : x)
+        for(double b : y)
+            u += a > b ? 1 : a == b ? 0.5 : 0;
+    return u;
+}
+
+// Returns the probability that U is at most `u`
+// when `m` and `n` samples are drawn from the same
+// distribution, counting the orderings exactly.
+double
+mann_whitney_p(
+    std::size_t m,
+    std::size_t n,
+    double u)
+{
+    // f[i][j][k] is the number of orderings of i and j
+    // samples in which U is k, built up from
+    // f(i,j,k) = f(i-1,j,k-j) + f(i,j-1,k)
+    std::vector<std::vector<std::vector<double>>> f(
+        m + 1, std::vector<std::vector<double>>(n + 1));
+    for(std::size_t i = 0; i <= m; ++i)
+    {
+        for(std::size_t j = 0; j <= n; ++j)
+        {
+            auto& v = f[i][j];
+            v.assign(i * j + 1, 0);
+            if(i == 0 || j == 0)
+            {
+                v[0] = 1;
+                continue;
+            }
+            for(std::size_t k = 0; k < v.size(); ++k)
+            {
+                if(k >= j && k - j < f[i - 1][j].size())
+                    v[k] += f[i - 1][j][k - j];
+                if(k < f[i][j - 1].size())
+                    v[k] += f[i][j - 1][k];
+            }
+        }
+    }
+    double total = 0;
+    double below = 0;
+    auto const& v = f[m][n];
+    for(std::size_t k = 0; k < v.size(); ++k)
+    {
+        total += v[k];
+        if(static_cast<double>(k) <= u)
+            below += v[k];
+    }
+    return below / total;
+}
+
+int
+compare(
+    char const* old_path,
+    char const* new_path)
+{
+    auto const before = load(old_path);
+    auto const after = load(new_path);
+
+    std::printf("%-60s %9s %9s %8s %7s\n",
+        "measurement", "old MB/s", "new MB/s",
+        "change", "p");
+    int slower = 0;
+    for(auto const& kv : before)
+    {
+        auto const it = after.find(kv.first);
+        if(it == after.end())
+        {
+            std::printf("%-60s %9.0f %9s\n",
+                kv.first.c_str(), kv.second.median, "-");
+            continue;
+        }
+        auto const& a = kv.second;
+        auto const& b = it->second;
+        double const change =
+            100 * (b.median - a.median) / a.median;
+        char const* verdict = "";
+        double p = 1;
+        if(a.trials.size() > 1 && b.trials.size() > 1)
+        {
+            auto const m = b.trials.size();
+            auto const n = a.trials.size();
+            if(change < 0)
+            {
+                p = mann_whitney_p(m, n,
+                    mann_whitney_u(b.trials, a.trials));
+                if(p < s_alpha && -change > s_threshold)
+                {
+                    verdict = "  SLOWER";
+                    ++slower;
+                }
+            }
+            else
+            {
+                p = mann_whitney_p(n, m,
+                    mann_whitney_u(a.trials, b.trials));
+                if(p < s_alpha && change > s_threshold)
+                    verdict = "  faster";
+            }
+        }
+        std::printf("%-60s %9.0f %9.0f %+7.1f%% %7.4f%s\n",
+            kv.first.c_str(), a.median, b.median,
+            change, p, verdict);
+    }
+    for(auto const& kv : after)
+        if(before.find(kv.first) == before.end())
+            std::printf("%-60s %9s %9.0f\n",
+                kv.first.c_str(), "-", kv.second.median);
+
+    if(slower > 0)
+    {
+        std::printf("\n%d measurement%s slower\n",
+            slower, slower == 1 ? " is" : "s are");
+        return 1;
+    }
+    return 0;
+}
+
+} // json
+} // boost
+
+//
+
+using namespace boost::json;
+
+static bool parse_option( char const * s )
+{
+    if( *s == 0 )
+    {
+        return false;
+    }
+
+    char opt = *s++;
+
+    if( *s++ != ':' )
+    {
+        return false;
+    }
+
+    double x = std::atof( s );
+
+    if( x <= 0 )
+    {
+        return false;
+    }
+
+    switch( opt )
+    {
+    case 'a':
+
+        s_alpha = x;
+        break;
+
+    case 't':
+
+        s_threshold = x;
+        break;
+
+    default:
+
+        return false;
+    }
+
+    return true;
+}
+
+int
+main(
+    int const argc,
+    char const* const* const argv)
+{
+    std::vector<char const*> files;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        char const * s = argv[ i ];
+
+        if( *s == '-' )
+        {
+            if( !parse_option( s+1 ) )
+            {
+                files.clear();
+                break;
+            }
+        }
+        else
+        {
+            files.push_back( s );
+        }
+    }
+
+    if( files.size() != 2 )
+    {
+        std::fprintf( stderr,
+            "Usage: bench_compare [options...] <old> <new>\n"
+            "\n"
+            "Compares two files written by bench -o:<file>.\n"
+            "\n"
+            "Options:  -a:<number>          Significance level (default 0.05)\n"
+            "          -t:<number>          Smallest slowdown reported, in percent\n"
+            "                                 (default 3)\n"
+            "\n"
+            "The exit status is 1 if any measurement is slower.\n" );
+        return 2;
+    }
+
+    try
+    {
+        return compare( files[0], files[1] );
+    }
+    catch( std::exception const& e )
+    {
+        std::fprintf( stderr, "%s\n", e.what() );
+        return 2;
+    }
+}
@@ -0,0 +1,81 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Writes a synthetic document to standard output
+
+#include "generate.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+
+using namespace boost::json;
+
+int
+main(
+    int const argc,
+    char const* const* const argv)
+{
+    std::uint64_t seed = 1;
+    std::string shape;
+    synthetic::param_map params;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        char const * s = argv[ i ];
+        char const * eq = std::strchr( s, '=' );
+
+        if( std::strncmp( s, "-s:", 3 ) == 0 )
+        {
+            seed = std::strtoull( s + 3, nullptr, 10 );
+        }
+        else if( eq )
+        {
+            params[ std::string( s, eq ) ] = std::atof( eq + 1 );
+        }
+        else if( shape.empty() && *s != '-' )
+        {
+            shape = s;
+        }
+        else
+        {
+            shape.clear();
+            break;
+        }
+    }
+
+    if( shape.empty() )
+    {
+        std::fprintf( stderr,
+            "Usage: bench_generate [-s:<seed>] <shape> [<name>=<value>...]\n"
+            "\n"
+            "Shapes and their parameters:\n"
+            "    nested   depth=100\n"
+            "    wide     keys=10000 key_length=8\n"
+            "    strings  count=1000 length=256 escapes=0\n"
+            "    numbers  count=100000 doubles=0.5\n"
+            "    ndjson   lines=1000\n" );
+        return 4;
+    }
+
+    try
+    {
+        std::string const text =
+            synthetic::generator( seed )( shape, params );
+        std::fwrite( text.data(), 1, text.size(), stdout );
+    }
+    catch( std::exception const& e )
+    {
+        std::fprintf( stderr, "%s\n", e.what() );
+        return 1;
+    }
+
+    return 0;
+}
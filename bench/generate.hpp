@@ -0,0 +1,238 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_BENCH_GENERATE_HPP
+#define BOOST_JSON_BENCH_GENERATE_HPP
+
+/*  Synthetic documents for benchmarks
+
+    Each shape is described by a few numeric parameters,
+    and the same parameters and seed always produce the
+    same text, so that results can be reproduced.
+
+    nested   depth      arrays and objects nested `depth` deep
+    wide     keys       one object with `keys` members, whose
+             key_length names have `key_length` characters
+    strings  count      an array of `count` strings of `length`
+             length     characters, of which the fraction
+             escapes    `escapes` are escape sequences
+    numbers  count      an array of `count` numbers, integers
+             doubles    except for the fraction `doubles`
+    ndjson   lines      `lines` small objects, one per line
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+namespace boost {
+namespace json {
+namespace synthetic {
+
+using param_map = std::map<std::string, double>;
+
+// Returns the parameter, or `def` if it was not given
+inline
+double
+param(
+    param_map const& p,
+    char const* name,
+    double def)
+{
+    auto const it = p.find(name);
+    return it == p.end() ? def : it->second;
+}
+
+class generator
+{
+    std::mt19937_64 rng_;
+    std::string s_;
+
+    std::size_t
+    below(std::size_t n)
+    {
+        return static_cast<std::size_t>(rng_() % n);
+    }
+
+    // The output of the distributions in <random>
+    // differs between standard libraries, unlike
+    // that of the engine, so doubles are made from
+    // the top 53 bits of the engine's output.
+    double
+    uniform()
+    {
+        return static_cast<double>(rng_() >> 11) /
+            9007199254740992.0; // 2^53
+    }
+
+    void
+    name(std::size_t length)
+    {
+        for(std::size_t i = 0; i < length; ++i)
+            s_.push_back(static_cast<char>(
+                'a' + below(26)));
+    }
+
+    void
+    number(double doubles)
+    {
+        char buf[32];
+        if(uniform() < doubles)
+            std::snprintf(buf, sizeof(buf), "%.17g",
+                2e6 * uniform() - 1e6);
+        else
+            // magnitudes spread over all digit counts
+            std::snprintf(buf, sizeof(buf), "%s%lld",
+                below(4) ? "" : "-",
+                static_cast<long long>(rng_() >> 1) >>
+                    below(63));
+        s_ += buf;
+    }
+
+    void
+    string(
+        std::size_t length,
+        double escapes)
+    {
+        static char const* const esc[] = {
+            "\\n", "\\\"", "\\\\", "\\t", "\\u00e9", "\\ud83d\\ude00" };
+        s_.push_back('"');
+        for(std::size_t i = 0; i < length;)
+        {
+            if(uniform() < escapes)
+            {
+                char const* const e = esc[below(6)];
+                s_ += e;
+                i += std::strlen(e);
+            }
+            else
+            {
+                s_.push_back(static_cast<char>(
+                    'a' + below(26)));
+                ++i;
+            }
+        }
+        s_.push_back('"');
+    }
+
+    void
+    record()
+    {
+        s_ += "{\"id\":";
+        number(0);
+        s_ += ",\"name\":";
+        string(12, 0);
+        s_ += ",\"score\":";
+        number(1);
+        s_ += ",\"tags\":[";
+        string(4, 0);
+        s_ += ",null,true]}";
+    }
+
+public:
+    explicit
+    generator(std::uint64_t seed)
+        : rng_(seed)
+    {
+    }
+
+    std::string
+    operator()(
+        std::string const& shape,
+        param_map const& p)
+    {
+        s_.clear();
+        if(shape == "nested")
+        {
+            auto const depth = static_cast<std::size_t>(
+                param(p, "depth", 100));
+            for(std::size_t i = 0; i < depth; ++i)
+                s_ += i % 2 ? "{\"k\":" : "[";
+            number(0);
+            for(std::size_t i = depth; i-- > 0;)
+                s_ += i % 2 ? "}" : "]";
+        }
+        else if(shape == "wide")
+        {
+            auto const keys = static_cast<std::size_t>(
+                param(p, "keys", 10000));
+            auto const key_length = static_cast<std::size_t>(
+                param(p, "key_length", 8));
+            s_.push_back('{');
+            for(std::size_t i = 0; i < keys; ++i)
+            {
+                if(i > 0)
+                    s_.push_back(',');
+                // a unique suffix keeps the keys distinct
+                s_.push_back('"');
+                name(key_length);
+                s_ += std::to_string(i);
+                s_ += "\":";
+                number(0);
+            }
+            s_.push_back('}');
+        }
+        else if(shape == "strings")
+        {
+            auto const count = static_cast<std::size_t>(
+                param(p, "count", 1000));
+            auto const length = static_cast<std::size_t>(
+                param(p, "length", 256));
+            auto const escapes = param(p, "escapes", 0);
+            s_.push_back('[');
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(i > 0)
+                    s_.push_back(',');
+                string(length, escapes);
+            }
+            s_.push_back(']');
+        }
+        else if(shape == "numbers")
+        {
+            auto const count = static_cast<std::size_t>(
+                param(p, "count", 100000));
+            auto const doubles = param(p, "doubles", 0.5);
+            s_.push_back('[');
+            for(std::size_t i = 0; i < count; ++i)
+            {
+                if(i > 0)
+                    s_.push_back(',');
+                number(doubles);
+            }
+            s_.push_back(']');
+        }
+        else if(shape == "ndjson")
+        {
+            auto const lines = static_cast<std::size_t>(
+                param(p, "lines", 1000));
+            for(std::size_t i = 0; i < lines; ++i)
+            {
+                record();
+                s_.push_back('\n');
+            }
+        }
+        else
+        {
+            throw std::invalid_argument(
+                "unknown shape: " + shape);
+        }
+        return s_;
+    }
+};
+
+} // synthetic
+} // json
+} // boost
+
+#endif
@@ -0,0 +1,535 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+/*  Micro-benchmarks for the inner loops of the library
+
+    Each kernel is measured over inputs drawn from a
+    controlled distribution, so that a change to one of
+    them shows up here even when it is lost in the noise
+    of a whole-document parse.
+*/
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/detail/digest.hpp>
+#include <boost/json/detail/format.hpp>
+#include <boost/json/detail/sse2.hpp>
+#include <boost/json/string_view.hpp>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+# include <intrin.h>
+# define BOOST_JSON_BENCH_HAS_TSC
+#elif defined(__x86_64__) || defined(__i386__)
+# include <x86intrin.h>
+# define BOOST_JSON_BENCH_HAS_TSC
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace json {
+
+using clock_type = std::chrono::steady_clock;
+
+std::size_t s_trials = 5;
+std::size_t s_millis = 100;
+
+// Values computed by the kernels are accumulated
+// here so that the optimizer cannot discard them.
+std::size_t volatile sink;
+
+// Time stamp counter ticks. On current x86 parts
+// these are reference cycles at the nominal
+// frequency, not core cycles, so bytes/cycle is
+// only comparable between runs on one machine.
+inline
+std::uint64_t
+ticks() noexcept
+{
+#ifdef BOOST_JSON_BENCH_HAS_TSC
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+struct kernel
+{
+    std::string name;
+
+    // bytes and operations in one pass
+    std::size_t bytes;
+    std::size_t ops;
+
+    // performs one pass, returns a checksum
+    std::function<std::size_t()> pass;
+};
+
+struct result
+{
+    double ns_per_op;
+    double bytes_per_cycle;
+};
+
+// Returns the best of the trials, each of which
+// repeats the pass for the configured interval.
+result
+measure(kernel const& k)
+{
+    result best{ 1e300, 0 };
+    for(std::size_t i = 0; i < s_trials; ++i)
+    {
+        std::size_t passes = 0;
+        std::size_t sum = 0;
+        auto const interval =
+            std::chrono::milliseconds(s_millis);
+        auto const t0 = ticks();
+        auto const when = clock_type::now();
+        auto elapsed = clock_type::now() - when;
+        do
+        {
+            sum += k.pass();
+            ++passes;
+            elapsed = clock_type::now() - when;
+        }
+        while(elapsed < interval);
+        auto const t1 = ticks();
+        sink = sum;
+
+        double const ns = static_cast<double>(
+            std::chrono::duration_cast<
+                std::chrono::nanoseconds>(
+                    elapsed).count());
+        double const ns_per_op = ns /
+            (static_cast<double>(passes) * k.ops);
+        if(ns_per_op < best.ns_per_op)
+        {
+            best.ns_per_op = ns_per_op;
+            best.bytes_per_cycle = t1 == t0 ? 0 :
+                static_cast<double>(passes) * k.bytes /
+                    static_cast<double>(t1 - t0);
+        }
+    }
+    return best;
+}
+
+//----------------------------------------------------------
+
+// about this many input bytes per pass, so
+// that the inputs stay in the L2 cache
+std::size_t const pass_bytes = 64 * 1024;
+
+std::size_t
+item_count(std::size_t size)
+{
+    return (std::max)(std::size_t(64),
+        pass_bytes / (size + 1));
+}
+
+// Runs of whitespace of `len` characters, like
+// the indentation of pretty-printed JSON, each
+// followed by a token.
+kernel
+make_whitespace(std::size_t len)
+{
+    auto buf = std::make_shared<std::string>();
+    auto offsets = std::make_shared<
+        std::vector<std::size_t>>();
+    for(std::size_t i = item_count(len); i--;)
+    {
+        offsets->push_back(buf->size());
+        if(len > 0)
+        {
+            buf->push_back('\n');
+            buf->append(len - 1, ' ');
+        }
+        buf->push_back('{');
+    }
+    return { "whitespace/" + std::to_string(len),
+        offsets->size() * len, offsets->size(),
+        [buf, offsets]
+        {
+            char const* const end =
+                buf->data() + buf->size();
+            std::size_t n = 0;
+            for(auto off : *offsets)
+            {
+                char const* p = buf->data() + off;
+                n += detail::count_whitespace(p, end) - p;
+            }
+            return n;
+        }};
+}
+
+// Strings of `len` characters in which each
+// character is, with probability `special`,
+// a backslash, and otherwise a non-ASCII code
+// point with probability `wide`, or else a
+// printable ASCII character.
+std::shared_ptr<std::vector<std::string>>
+make_strings(
+    std::size_t len,
+    double special,
+    double wide)
+{
+    std::mt19937 rng(static_cast<unsigned>(len));
+    std::uniform_real_distribution<double> u;
+    auto v = std::make_shared<
+        std::vector<std::string>>();
+    for(std::size_t i = item_count(len); i--;)
+    {
+        std::string s;
+        while(s.size() < len)
+        {
+            double const x = u(rng);
+            if(x < special)
+                s.push_back('\\');
+            else if(x < special + wide &&
+                len - s.size() >= 2)
+                s.append("\xc3\xa9"); // U+00E9
+            else
+                s.push_back(static_cast<char>(
+                    'a' + rng() % 26));
+        }
+        v->push_back(std::move(s));
+    }
+    return v;
+}
+
+std::string
+suffix(double x)
+{
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%g", x);
+    return buf;
+}
+
+// count_valid scans string bodies in the parser.
+// Each stop is skipped, as the parser would after
+// handling an escape.
+template<bool AllowBadUTF8>
+kernel
+make_valid(
+    std::size_t len,
+    double special,
+    double wide)
+{
+    auto v = make_strings(len, special, wide);
+    std::string name = AllowBadUTF8 ?
+        "count_valid/" : "count_valid_utf8/";
+    name += std::to_string(len) +
+        "/esc=" + suffix(special);
+    if(! AllowBadUTF8)
+        name += "/wide=" + suffix(wide);
+    return { name, v->size() * len, v->size(),
+        [v]
+        {
+            std::size_t n = 0;
+            for(auto const& s : *v)
+            {
+                char const* p = s.data();
+                char const* const end = p + s.size();
+                while(p != end)
+                {
+                    p = detail::count_valid<
+                        AllowBadUTF8>(p, end);
+                    if(p != end)
+                    {
+                        ++p;
+                        ++n;
+                    }
+                }
+            }
+            return n;
+        }};
+}
+
+// count_unescaped finds the runs which the
+// serializer can copy without escaping.
+kernel
+make_unescaped(
+    std::size_t len,
+    double special)
+{
+    auto v = make_strings(len, special, 0);
+    return { "count_unescaped/" + std::to_string(len) +
+            "/esc=" + suffix(special),
+        v->size() * len, v->size(),
+        [v]
+        {
+            std::size_t n = 0;
+            for(auto const& s : *v)
+            {
+                char const* p = s.data();
+                char const* const end = p + s.size();
+                while(p != end)
+                {
+                    auto const k = detail::count_unescaped(
+                        p, static_cast<std::size_t>(end - p));
+                    // the tail and each escape go
+                    // through the serializer's slow loop
+                    p += k ? k : 1;
+                    ++n;
+                }
+            }
+            return n;
+        }};
+}
+
+// digest hashes object keys
+kernel
+make_digest(std::size_t len)
+{
+    auto v = make_strings(len, 0, 0);
+    return { "digest/" + std::to_string(len),
+        v->size() * len, v->size(),
+        [v]
+        {
+            std::size_t h = 0;
+            for(auto const& s : *v)
+                h ^= detail::digest(s.data(), s.size());
+            return h;
+        }};
+}
+
+// unsigned integers of exactly `digits` digits
+kernel
+make_format_uint64(unsigned digits)
+{
+    std::mt19937_64 rng(digits);
+    std::uint64_t lo = 1;
+    for(unsigned i = 1; i < digits; ++i)
+        lo *= 10;
+    std::uint64_t const hi = digits < 20 ?
+        lo * 10 - 1 : std::uint64_t(-1);
+    if(digits == 1)
+        lo = 0;
+    std::uniform_int_distribution<
+        std::uint64_t> dist(lo, hi);
+    auto v = std::make_shared<
+        std::vector<std::uint64_t>>();
+    for(std::size_t i = item_count(digits); i--;)
+        v->push_back(dist(rng));
+    return { "format_uint64/" + std::to_string(digits),
+        v->size() * digits, v->size(),
+        [v]
+        {
+            char buf[detail::max_number_chars];
+            std::size_t n = 0;
+            for(auto u : *v)
+                n += detail::format_uint64(buf, u);
+            return n;
+        }};
+}
+
+// doubles from a distribution, formatted with ryu
+kernel
+make_format_double(
+    char const* dist_name,
+    std::function<double(std::mt19937_64&)> gen)
+{
+    std::mt19937_64 rng(42);
+    auto v = std::make_shared<
+        std::vector<double>>();
+    std::size_t bytes = 0;
+    char buf[detail::max_number_chars + 1];
+    for(std::size_t i = item_count(16); i--;)
+    {
+        double const d = gen(rng);
+        bytes += detail::format_double(buf, d);
+        v->push_back(d);
+    }
+    return { std::string("format_double/") + dist_name,
+        bytes, v->size(),
+        [v]
+        {
+            char buf[detail::max_number_chars + 1];
+            std::size_t n = 0;
+            for(auto d : *v)
+                n += detail::format_double(buf, d);
+            return n;
+        }};
+}
+
+std::vector<kernel>
+make_kernels()
+{
+    std::vector<kernel> v;
+    for(std::size_t len : {0, 1, 2, 4, 8, 16, 32, 64, 256})
+        v.push_back(make_whitespace(len));
+    for(std::size_t len : {8, 16, 32, 64, 256, 4096})
+    {
+        for(double esc : {0.0, 1.0 / 64, 1.0 / 8})
+            v.push_back(make_valid<true>(len, esc, 0));
+        for(double wide : {0.0, 1.0 / 16, 1.0 / 2})
+            v.push_back(make_valid<false>(len, 0, wide));
+        for(double esc : {0.0, 1.0 / 64, 1.0 / 8})
+            v.push_back(make_unescaped(len, esc));
+    }
+    for(std::size_t len : {4, 8, 16, 32, 64, 256})
+        v.push_back(make_digest(len));
+    for(unsigned digits : {1, 2, 4, 8, 12, 16, 19, 20})
+        v.push_back(make_format_uint64(digits));
+    v.push_back(make_format_double("small_int",
+        [](std::mt19937_64& rng)
+        {
+            return static_cast<double>(rng() % 1000);
+        }));
+    v.push_back(make_format_double("two_places",
+        [](std::mt19937_64& rng)
+        {
+            return static_cast<double>(
+                rng() % 1000000) / 100;
+        }));
+    v.push_back(make_format_double("coordinate",
+        [](std::mt19937_64& rng)
+        {
+            return std::uniform_real_distribution<
+                double>(-180, 180)(rng);
+        }));
+    v.push_back(make_format_double("random_bits",
+        [](std::mt19937_64& rng)
+        {
+            for(;;)
+            {
+                std::uint64_t u = rng();
+                double d;
+                std::memcpy(&d, &u, sizeof(d));
+                if(d == d && d - d == 0) // finite
+                    return d;
+            }
+        }));
+    return v;
+}
+
+} // json
+} // boost
+
+//
+
+using namespace boost::json;
+
+static bool parse_option( char const * s )
+{
+    if( *s == 0 )
+    {
+        return false;
+    }
+
+    char opt = *s++;
+
+    if( *s++ != ':' )
+    {
+        return false;
+    }
+
+    int k = std::atoi( s );
+
+    if( k <= 0 )
+    {
+        return false;
+    }
+
+    switch( opt )
+    {
+    case 'n':
+
+        s_trials = k;
+        break;
+
+    case 'm':
+
+        s_millis = k;
+        break;
+
+    default:
+
+        return false;
+    }
+
+    return true;
+}
+
+int
+main(
+    int const argc,
+    char const* const* const argv)
+{
+    std::vector<string_view> filters;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        char const * s = argv[ i ];
+
+        if( *s == '-' )
+        {
+            if( !parse_option( s+1 ) )
+            {
+                std::fprintf( stderr,
+                    "Usage: bench_kernels [options...] [filter...]\n"
+                    "\n"
+                    "Options:  -n:<number>          Number of trials (default 5)\n"
+                    "          -m:<number>          Milliseconds per trial (default 100)\n"
+                    "\n"
+                    "Only the kernels whose names contain one of the\n"
+                    "filters are run, or all of them if there are none.\n" );
+                return 4;
+            }
+        }
+        else
+        {
+            filters.emplace_back( s );
+        }
+    }
+
+    std::printf( "%-40s %10s %12s\n",
+        "kernel", "ns/op",
+#ifdef BOOST_JSON_BENCH_HAS_TSC
+        "bytes/cycle"
+#else
+        "MB/s"
+#endif
+        );
+
+    for( auto const& k : make_kernels() )
+    {
+        if( ! filters.empty() && std::none_of(
+            filters.begin(), filters.end(),
+            [&k]( string_view f )
+            {
+                return k.name.find(
+                    f.data(), 0, f.size() ) !=
+                        std::string::npos;
+            }))
+        {
+            continue;
+        }
+
+        auto const r = measure( k );
+#ifdef BOOST_JSON_BENCH_HAS_TSC
+        double const rate = r.bytes_per_cycle;
+#else
+        double const rate = 1000.0 * k.bytes /
+            k.ops / r.ns_per_op;
+#endif
+        std::printf( "%-40s %10.2f %12.3f\n",
+            k.name.c_str(), r.ns_per_op, rate );
+    }
+
+    return 0;
+}
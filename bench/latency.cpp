@@ -0,0 +1,398 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+/*  Latency distribution of small parses and serializations
+
+    Every operation is timed on its own, so the fixed
+    costs of each call, such as constructing a parser,
+    setting up its stack and making the first
+    allocation, show up in the percentiles instead of
+    being averaged away over a large file.
+*/
+
+#include <boost/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace json {
+
+using clock_type = std::chrono::steady_clock;
+
+std::size_t s_samples = 100000;
+bool s_histogram = false;
+
+// Values computed by the operations are accumulated
+// here so that the optimizer cannot discard them.
+std::size_t volatile sink;
+
+struct document
+{
+    std::string name;
+    std::string text;
+};
+
+// A request body of about `size` bytes, shaped
+// like the payloads of a typical web service.
+std::string
+make_request(std::size_t size)
+{
+    std::mt19937 rng(static_cast<unsigned>(size));
+    std::string s = R"({"id":)" + std::to_string(rng()) +
+        R"(,"method":"update","user":{"name":"user)" +
+        std::to_string(rng() % 1000) +
+        R"(","verified":true,"score":)" +
+        std::to_string(rng() % 10000) + "." +
+        std::to_string(rng() % 100) + R"(},"items":[)";
+    for(int i = 0; s.size() + 80 < size; ++i)
+    {
+        if(i > 0)
+            s += ',';
+        s += R"({"sku":"A-)" + std::to_string(rng() % 100000) +
+            R"(","qty":)" + std::to_string(1 + rng() % 9) +
+            R"(,"price":)" + std::to_string(rng() % 500) + "." +
+            std::to_string(10 + rng() % 90) +
+            R"(,"tags":["x",null]})";
+    }
+    s += R"(],"note":"été \"quoted\""})";
+    return s;
+}
+
+// A cheap use of the result, so that
+// the work cannot be optimized away
+std::size_t
+weight(value const& jv) noexcept
+{
+    if(auto p = jv.if_object())
+        return p->size();
+    if(auto p = jv.if_array())
+        return p->size();
+    return 1;
+}
+
+// The operation under test, timed once per call
+struct variant
+{
+    char const* name;
+    std::function<void(std::string const&)> setup;
+    std::function<std::size_t()> run;
+};
+
+std::vector<variant>
+make_variants()
+{
+    // state shared by the variants, set up
+    // for each document before it is timed
+    struct state
+    {
+        std::string text;
+        value jv;
+        parser p;
+        stream_parser sp;
+        serializer sr;
+        unsigned char temp[4096];
+        unsigned char buf[16384];
+    };
+    auto st = std::make_shared<state>();
+    auto const set = [st](std::string const& s)
+    {
+        st->text = s;
+        st->jv = json::parse(s);
+    };
+
+    std::vector<variant> v;
+    v.push_back({ "parse", set,
+        [st]
+        {
+            return weight(json::parse(st->text));
+        }});
+    v.push_back({ "parser (reused)", set,
+        [st]
+        {
+            st->p.reset();
+            st->p.write(st->text);
+            return weight(st->p.release());
+        }});
+    v.push_back({ "parser (new)", set,
+        [st]
+        {
+            parser p;
+            p.write(st->text);
+            return weight(p.release());
+        }});
+    v.push_back({ "stream_parser (reused)", set,
+        [st]
+        {
+            st->sp.reset();
+            st->sp.write(st->text);
+            st->sp.finish();
+            return weight(st->sp.release());
+        }});
+    v.push_back({ "parse (monotonic buffer)", set,
+        [st]
+        {
+            monotonic_resource mr(
+                st->buf, sizeof(st->buf));
+            return weight(json::parse(st->text, &mr));
+        }});
+    v.push_back({ "parser (temp and monotonic buffer)", set,
+        [st]
+        {
+            monotonic_resource mr(
+                st->buf, sizeof(st->buf));
+            parser p(storage_ptr(), parse_options(),
+                st->temp, sizeof(st->temp));
+            p.reset(&mr);
+            p.write(st->text);
+            return weight(p.release());
+        }});
+    v.push_back({ "serialize", set,
+        [st]
+        {
+            return json::serialize(st->jv).size();
+        }});
+    v.push_back({ "serializer (reused)", set,
+        [st]
+        {
+            char buf[4096];
+            std::size_t n = 0;
+            st->sr.reset(&st->jv);
+            while(! st->sr.done())
+                n += st->sr.read(buf, sizeof(buf)).size();
+            return n;
+        }});
+    return v;
+}
+
+// The cost of reading the clock, which is
+// included in every sample.
+double
+clock_overhead()
+{
+    std::vector<double> v;
+    for(int i = 0; i < 10000; ++i)
+    {
+        auto const t0 = clock_type::now();
+        auto const t1 = clock_type::now();
+        v.push_back(std::chrono::duration<
+            double, std::nano>(t1 - t0).count());
+    }
+    std::sort(v.begin(), v.end());
+    return v[v.size() / 2];
+}
+
+double
+percentile(
+    std::vector<double> const& v,
+    double p)
+{
+    auto const i = static_cast<std::size_t>(
+        p * static_cast<double>(v.size() - 1) + 0.5);
+    return v[i];
+}
+
+// Prints the count of samples in each power of
+// two range of nanoseconds.
+void
+print_histogram(std::vector<double> const& v)
+{
+    std::size_t lo = 1;
+    auto it = v.begin();
+    while(it != v.end())
+    {
+        auto const end = std::lower_bound(
+            it, v.end(), static_cast<double>(lo * 2));
+        auto const n = end - it;
+        if(n > 0)
+        {
+            int const bar = static_cast<int>(
+                0.5 + 50.0 * n / v.size());
+            std::printf("    %8zu ns  %8ld  %.*s\n",
+                lo, static_cast<long>(n), bar,
+                "##################################################");
+        }
+        it = end;
+        lo *= 2;
+    }
+}
+
+void
+bench(
+    document const& d,
+    variant const& var)
+{
+    var.setup(d.text);
+    std::size_t sum = 0;
+    // warm up the caches and allocator
+    for(int i = 0; i < 1000; ++i)
+        sum += var.run();
+    std::vector<double> v;
+    v.reserve(s_samples);
+    for(std::size_t i = 0; i < s_samples; ++i)
+    {
+        auto const t0 = clock_type::now();
+        sum += var.run();
+        auto const t1 = clock_type::now();
+        v.push_back(std::chrono::duration<
+            double, std::nano>(t1 - t0).count());
+    }
+    std::sort(v.begin(), v.end());
+    std::printf(
+        "%-10s %-36s %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f\n",
+        d.name.c_str(), var.name,
+        v.front(),
+        percentile(v, 0.5),
+        percentile(v, 0.9),
+        percentile(v, 0.99),
+        percentile(v, 0.999),
+        v.back());
+    sink = sum;
+    if(s_histogram)
+        print_histogram(v);
+}
+
+} // json
+} // boost
+
+//
+
+using namespace boost::json;
+
+std::string
+load_file(char const* path)
+{
+    std::string s;
+    FILE* f = fopen(path, "rb");
+    if(! f)
+        return s;
+    char buf[4096];
+    std::size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        s.append(buf, n);
+    fclose(f);
+    return s;
+}
+
+static bool parse_option( char const * s )
+{
+    if( *s == 0 )
+    {
+        return false;
+    }
+
+    char opt = *s++;
+
+    if( *s++ != ':' )
+    {
+        return false;
+    }
+
+    int k = std::atoi( s );
+
+    switch( opt )
+    {
+    case 'n':
+
+        if( k <= 0 )
+        {
+            return false;
+        }
+
+        s_samples = k;
+        break;
+
+    case 'h':
+
+        s_histogram = k != 0;
+        break;
+
+    default:
+
+        return false;
+    }
+
+    return true;
+}
+
+int
+main(
+    int const argc,
+    char const* const* const argv)
+{
+    std::vector<document> vd;
+
+    for( int i = 1; i < argc; ++i )
+    {
+        char const * s = argv[ i ];
+
+        if( *s == '-' )
+        {
+            if( !parse_option( s+1 ) )
+            {
+                std::fprintf( stderr,
+                    "Usage: bench_latency [options...] [file...]\n"
+                    "\n"
+                    "Options:  -n:<number>          Samples per variant (default 100000)\n"
+                    "          -h:1                 Print a histogram of each variant\n"
+                    "\n"
+                    "Without files, generated requests of 200, 1000\n"
+                    "and 4000 bytes are used.\n" );
+                return 4;
+            }
+        }
+        else
+        {
+            vd.push_back( { s, load_file( s ) } );
+        }
+    }
+
+    if( vd.empty() )
+    {
+        for( std::size_t n : { 200, 1000, 4000 } )
+        {
+            vd.push_back( { std::to_string( n ) + "B",
+                make_request( n ) } );
+        }
+    }
+
+    std::printf( "clock overhead %.0f ns, included below\n\n",
+        clock_overhead() );
+    std::printf(
+        "%-10s %-36s %8s %8s %8s %8s %8s %8s\n",
+        "document", "variant",
+        "min", "p50", "p90", "p99", "p99.9", "max" );
+
+    try
+    {
+        auto const vv = make_variants();
+        for( auto const& d : vd )
+        {
+            for( auto const& var : vv )
+            {
+                bench( d, var );
+            }
+        }
+    }
+    catch( std::exception const& e )
+    {
+        std::fprintf( stderr, "%s\n", e.what() );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,288 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+/*  Throughput of the serializer by output buffer size
+
+    Each document is serialized with serializer::read into
+    fixed buffers, from a few bytes up to one which holds
+    the whole output, and with serialize into a string.
+    When the buffer fills in the middle of a string, a
+    number or a container, the serializer suspends and
+    resumes on the next call, so the small buffers show
+    the cost of those paths for each shape of value.
+*/
+
+#include <boost/json.hpp>
+
+#include "generate.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace json {
+
+using clock_type = std::chrono::steady_clock;
+
+std::size_t s_trials = 3;
+std::size_t s_millis = 1000;
+
+// Values computed by the serializations are accumulated
+// here so that the optimizer cannot discard them.
+std::size_t volatile sink;
+
+struct document
+{
+    std::string name;
+    value jv;
+};
+
+// The way the output is produced, returning its size
+struct method
+{
+    std::string name;
+    std::function<std::size_t(value const&)> run;
+};
+
+std::vector<method>
+make_methods(std::size_t size)
+{
+    std::vector<method> v;
+    // 4000 is the buffer of the example in the
+    // serializer documentation
+    for(std::size_t n : { 64, 512, 4000, 65536 })
+    {
+        auto const buf =
+            std::make_shared<std::vector<char>>(n);
+        v.push_back({ "read " + std::to_string(n),
+            [buf](value const& jv)
+            {
+                serializer sr;
+                sr.reset(&jv);
+                std::size_t total = 0;
+                while(! sr.done())
+                    total += sr.read(
+                        buf->data(), buf->size()).size();
+                return total;
+            }});
+    }
+    auto const whole =
+        std::make_shared<std::vector<char>>(size);
+    v.push_back({ "read whole",
+        [whole](value const& jv)
+        {
+            serializer sr;
+            sr.reset(&jv);
+            return sr.read(
+                whole->data(), whole->size()).size();
+        }});
+    v.push_back({ "serialize",
+        [](value const& jv)
+        {
+            return json::serialize(jv).size();
+        }});
+    v.push_back({ "serialize canonical",
+        [](value const& jv)
+        {
+            serialize_options opts;
+            opts.canonical = true;
+            return json::serialize(jv, opts).size();
+        }});
+    return v;
+}
+
+// Returns the number of bytes produced per
+// second, the best of several trials.
+double
+measure(
+    method const& m,
+    value const& jv,
+    std::size_t size)
+{
+    double best = 0;
+    for(std::size_t k = 0; k < s_trials; ++k)
+    {
+        std::size_t n = 0;
+        std::size_t sum = 0;
+        auto const interval =
+            std::chrono::milliseconds(s_millis);
+        auto const t0 = clock_type::now();
+        auto elapsed = clock_type::now() - t0;
+        do
+        {
+            sum += m.run(jv);
+            ++n;
+            elapsed = clock_type::now() - t0;
+        }
+        while(elapsed < interval);
+        sink = sum;
+        auto const seconds = std::chrono::duration<
+            double>(elapsed).count();
+        best = (std::max)(best,
+            static_cast<double>(n) * size / seconds);
+    }
+    return best;
+}
+
+void
+bench(document const& d)
+{
+    auto const size = json::serialize(d.jv).size();
+    for(auto const& m : make_methods(size))
+    {
+        auto const bps = measure(m, d.jv, size);
+        std::printf("%-24s %-20s %10.1f\n",
+            d.name.c_str(), m.name.c_str(),
+            bps / 1024 / 1024);
+        std::fflush(stdout);
+    }
+}
+
+parse_options
+make_parse_options()
+{
+    parse_options opt;
+    opt.max_depth = 10000;
+    return opt;
+}
+
+} // json
+} // boost
+
+//
+
+using namespace boost::json;
+
+std::string
+load_file(char const* path)
+{
+    std::string s;
+    FILE* f = fopen(path, "rb");
+    if(! f)
+        return s;
+    char buf[4096];
+    std::size_t n;
+    while((n = fread(buf, 1, sizeof(buf), f)) > 0)
+        s.append(buf, n);
+    fclose(f);
+    return s;
+}
+
+static bool parse_option( char const * s )
+{
+    if( *s == 0 )
+    {
+        return false;
+    }
+
+    char opt = *s++;
+
+    if( *s++ != ':' )
+    {
+        return false;
+    }
+
+    int k = std::atoi( s );
+
+    if( k <= 0 )
+    {
+        return false;
+    }
+
+    switch( opt )
+    {
+    case 'n':
+
+        s_trials = k;
+        break;
+
+    case 'm':
+
+        s_millis = k;
+        break;
+
+    default:
+
+        return false;
+    }
+
+    return true;
+}
+
+int
+main(
+    int const argc,
+    char const* const* const argv)
+{
+    std::vector<document> vd;
+
+    try
+    {
+        for( int i = 1; i < argc; ++i )
+        {
+            char const * s = argv[ i ];
+
+            if( *s == '-' )
+            {
+                if( !parse_option( s+1 ) )
+                {
+                    std::fprintf( stderr,
+                        "Usage: bench_serialize [options...] [file...]\n"
+                        "\n"
+                        "Options:  -n:<number>          Trials per method, the best\n"
+                        "                                 is reported (default 3)\n"
+                        "          -m:<number>          Milliseconds per trial (default 1000)\n"
+                        "\n"
+                        "Without files, generated string heavy, number heavy\n"
+                        "and deeply nested documents are used.\n" );
+                    return 4;
+                }
+            }
+            else
+            {
+                vd.push_back( { s, parse(
+                    load_file( s ), {}, make_parse_options() ) } );
+            }
+        }
+
+        if( vd.empty() )
+        {
+            synthetic::generator g( 1 );
+            vd.push_back( { "strings", parse( g( "strings",
+                { { "count", 10000 }, { "length", 64 },
+                  { "escapes", 0.05 } } ) ) } );
+            vd.push_back( { "numbers", parse( g( "numbers",
+                { { "count", 100000 }, { "doubles", 0.5 } } ) ) } );
+            vd.push_back( { "nested", parse( g( "nested",
+                { { "depth", 5000 } } ), {}, make_parse_options() ) } );
+        }
+
+        std::printf( "%-24s %-20s %10s\n",
+            "document", "method", "MB/s" );
+
+        for( auto const& d : vd )
+        {
+            bench( d );
+        }
+    }
+    catch( std::exception const& e )
+    {
+        std::fprintf( stderr, "%s\n", e.what() );
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,576 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+//[example_ingest
+
+/*
+    This example parses many files while keeping reads
+    in flight, so that disk latency overlaps with parsing.
+
+    The files are read in fixed size chunks through a ring
+    of buffers. While the parser consumes one chunk, reads
+    for the following chunks, which may belong to the next
+    files, are already pending. On Linux the reads are
+    submitted in batches through io_uring; if io_uring is
+    not available, a small pool of threads calls pread.
+*/
+
+#include <boost/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+# if __has_include(<linux/io_uring.h>)
+#  define EXAMPLE_HAS_IO_URING
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+# endif
+#endif
+
+using namespace boost::json;
+
+// A read of one chunk of a file into a buffer
+struct slot
+{
+    std::unique_ptr<char[]> buf;
+    iovec iov;
+    int fd = -1;
+    std::size_t file = 0;       // index of the file
+    std::uint64_t offset = 0;
+    std::size_t size = 0;       // bytes requested
+    long result = 0;            // bytes read, or -errno
+    bool last = false;          // the final chunk of the file
+    bool used = false;          // holds a read
+    bool done = false;          // the read has completed
+};
+
+// Finish a short read synchronously. Regular files
+// only return fewer bytes than requested at the end.
+inline
+void
+complete(slot& s)
+{
+    while( s.result >= 0 &&
+        static_cast<std::size_t>(s.result) < s.size)
+    {
+        auto const n = ::pread(s.fd,
+            s.buf.get() + s.result,
+            s.size - s.result,
+            s.offset + s.result);
+        if(n < 0)
+            s.result = -errno;
+        else if(n == 0)
+            break;
+        else
+            s.result += n;
+    }
+}
+
+class io_backend
+{
+public:
+    virtual ~io_backend() = default;
+
+    // queue a read, it may not start until wait is called
+    virtual void submit(slot& s) = 0;
+
+    // block until the read is complete
+    virtual void wait(slot& s) = 0;
+};
+
+//----------------------------------------------------------
+
+// Reads with pread on a pool of threads
+class pread_backend : public io_backend
+{
+    std::mutex m_;
+    std::condition_variable cv_;        // work was queued
+    std::condition_variable done_cv_;   // work was completed
+    std::deque<slot*> q_;
+    std::vector<std::thread> threads_;
+    bool stop_ = false;
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(m_);
+        for(;;)
+        {
+            cv_.wait(lock, [this]{ return stop_ || ! q_.empty(); });
+            if(q_.empty())
+                return;
+            slot& s = *q_.front();
+            q_.pop_front();
+            lock.unlock();
+            s.result = 0;
+            complete(s);
+            lock.lock();
+            s.done = true;
+            done_cv_.notify_all();
+        }
+    }
+
+public:
+    explicit
+    pread_backend(unsigned threads)
+    {
+        for(unsigned i = 0; i < threads; ++i)
+            threads_.emplace_back([this]{ run(); });
+    }
+
+    ~pread_backend()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        for(auto& t : threads_)
+            t.join();
+    }
+
+    void
+    submit(slot& s) override
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_);
+            s.done = false;
+            q_.push_back(&s);
+        }
+        cv_.notify_one();
+    }
+
+    void
+    wait(slot& s) override
+    {
+        std::unique_lock<std::mutex> lock(m_);
+        done_cv_.wait(lock, [&s]{ return s.done; });
+    }
+};
+
+//----------------------------------------------------------
+
+#ifdef EXAMPLE_HAS_IO_URING
+
+// Reads with io_uring, using the raw system calls
+// so that liburing is not required.
+class uring_backend : public io_backend
+{
+    int fd_ = -1;
+    unsigned* sq_tail_;
+    unsigned sq_mask_;
+    unsigned* sq_array_;
+    io_uring_sqe* sqes_;
+    unsigned* cq_head_;
+    unsigned* cq_tail_;
+    unsigned cq_mask_;
+    io_uring_cqe* cqes_;
+    void* sq_ptr_ = MAP_FAILED;
+    void* cq_ptr_ = MAP_FAILED;
+    std::size_t sq_size_ = 0;
+    std::size_t cq_size_ = 0;
+    std::size_t sqes_size_ = 0;
+    unsigned pending_ = 0;              // queued, not yet entered
+
+    static
+    int
+    enter(
+        int fd,
+        unsigned to_submit,
+        unsigned min_complete,
+        unsigned flags)
+    {
+        return static_cast<int>(::syscall(
+            __NR_io_uring_enter, fd, to_submit,
+            min_complete, flags, nullptr, 0));
+    }
+
+    // move completions into their slots
+    void
+    reap()
+    {
+        unsigned head = *cq_head_;
+        unsigned const tail =
+            __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        for(; head != tail; ++head)
+        {
+            io_uring_cqe const& cqe = cqes_[head & cq_mask_];
+            slot& s = *reinterpret_cast<
+                slot*>(cqe.user_data);
+            s.result = cqe.res;
+            s.done = true;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+
+public:
+    // returns false if io_uring is not available
+    bool
+    open(unsigned entries)
+    {
+        io_uring_params p;
+        std::memset(&p, 0, sizeof(p));
+        fd_ = static_cast<int>(::syscall(
+            __NR_io_uring_setup, entries, &p));
+        if(fd_ < 0)
+            return false;
+        sq_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        if(p.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if(cq_size_ > sq_size_)
+                sq_size_ = cq_size_;
+            cq_size_ = 0;
+        }
+        sq_ptr_ = ::mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_SQ_RING);
+        if(sq_ptr_ == MAP_FAILED)
+            return false;
+        void* cq = sq_ptr_;
+        if(cq_size_)
+        {
+            cq_ptr_ = ::mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, fd_, IORING_OFF_CQ_RING);
+            if(cq_ptr_ == MAP_FAILED)
+                return false;
+            cq = cq_ptr_;
+        }
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        void* const sqes = ::mmap(nullptr, sqes_size_,
+            PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+            fd_, IORING_OFF_SQES);
+        if(sqes == MAP_FAILED)
+        {
+            sqes_size_ = 0;
+            return false;
+        }
+        auto const sq = static_cast<char*>(sq_ptr_);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        sqes_ = static_cast<io_uring_sqe*>(sqes);
+        auto const cqp = static_cast<char*>(cq);
+        cq_head_ = reinterpret_cast<unsigned*>(cqp + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cqp + p.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cqp + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cqp + p.cq_off.cqes);
+        return true;
+    }
+
+    ~uring_backend()
+    {
+        if(sqes_size_)
+            ::munmap(sqes_, sqes_size_);
+        if(cq_ptr_ != MAP_FAILED)
+            ::munmap(cq_ptr_, cq_size_);
+        if(sq_ptr_ != MAP_FAILED)
+            ::munmap(sq_ptr_, sq_size_);
+        if(fd_ >= 0)
+            ::close(fd_);
+    }
+
+    void
+    submit(slot& s) override
+    {
+        // The caller never has more reads in flight
+        // than there are entries, so there is room.
+        unsigned const tail = *sq_tail_;
+        unsigned const i = tail & sq_mask_;
+        io_uring_sqe& sqe = sqes_[i];
+        std::memset(&sqe, 0, sizeof(sqe));
+        sqe.opcode = IORING_OP_READV;
+        sqe.fd = s.fd;
+        sqe.addr = reinterpret_cast<std::uintptr_t>(&s.iov);
+        sqe.len = 1;
+        sqe.off = s.offset;
+        sqe.user_data = reinterpret_cast<std::uintptr_t>(&s);
+        sq_array_[i] = i;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        s.done = false;
+        ++pending_;
+    }
+
+    void
+    wait(slot& s) override
+    {
+        reap();
+        while(! s.done)
+        {
+            int const n = enter(fd_, pending_, 1,
+                IORING_ENTER_GETEVENTS);
+            if(n < 0 && errno != EINTR)
+            {
+                std::cerr << "io_uring_enter: " <<
+                    std::strerror(errno) << "\n";
+                std::exit(EXIT_FAILURE);
+            }
+            if(n > 0)
+                pending_ -= n;
+            reap();
+        }
+        complete(s);
+    }
+};
+
+#endif
+
+//----------------------------------------------------------
+
+// Parses a list of files, reading ahead through a ring of slots
+class ingest
+{
+    struct file_state
+    {
+        char const* path;
+        std::uint64_t size = 0;
+        int fd = -1;
+        bool failed = false;
+    };
+
+    io_backend& io_;
+    std::vector<file_state> files_;
+    std::vector<slot> slots_;
+    std::size_t chunk_;
+    std::size_t next_file_ = 0;         // file of the next read
+    std::uint64_t next_offset_ = 0;     // offset of the next read
+
+public:
+    std::size_t parsed = 0;
+    std::size_t failed = 0;
+    std::uint64_t bytes = 0;
+
+    ingest(
+        io_backend& io,
+        std::vector<char const*> const& paths,
+        std::size_t depth,
+        std::size_t chunk)
+        : io_(io)
+        , slots_(depth)
+        , chunk_(chunk)
+    {
+        for(auto path : paths)
+        {
+            file_state f;
+            f.path = path;
+            files_.push_back(f);
+        }
+        for(auto& s : slots_)
+        {
+            s.buf.reset(new char[chunk]);
+            s.iov.iov_base = s.buf.get();
+        }
+    }
+
+    void
+    run()
+    {
+        stream_parser p;
+        for(auto& s : slots_)
+            issue(s);
+        for(std::size_t k = 0;; ++k)
+        {
+            slot& s = slots_[k % slots_.size()];
+            if(! s.used)
+                break;
+            io_.wait(s);
+            consume(p, s);
+            issue(s);
+        }
+    }
+
+private:
+    void
+    fail(file_state& f, std::string const& what)
+    {
+        if(f.failed)
+            return;
+        f.failed = true;
+        ++failed;
+        std::cerr << f.path << ": " << what << "\n";
+    }
+
+    // start the next read in the sequence, if any
+    void
+    issue(slot& s)
+    {
+        s.used = false;
+        if(next_file_ == files_.size())
+            return;
+        file_state& f = files_[next_file_];
+        if(next_offset_ == 0)
+        {
+            f.fd = ::open(f.path, O_RDONLY);
+            struct stat st;
+            if(f.fd >= 0 && ::fstat(f.fd, &st) == 0)
+                f.size = static_cast<std::uint64_t>(st.st_size);
+            else
+                f.size = 0;
+        }
+        s.used = true;
+        s.file = next_file_;
+        s.fd = f.fd;
+        s.offset = next_offset_;
+        s.size = static_cast<std::size_t>(
+            f.size - next_offset_ < chunk_ ?
+                f.size - next_offset_ : chunk_);
+        s.iov.iov_len = s.size;
+        s.result = f.fd < 0 ? -errno : 0;
+        next_offset_ += s.size;
+        s.last = next_offset_ == f.size;
+        if(s.last)
+        {
+            ++next_file_;
+            next_offset_ = 0;
+        }
+        if(s.size == 0)
+            s.done = true;
+        else
+            io_.submit(s);
+    }
+
+    void
+    consume(stream_parser& p, slot& s)
+    {
+        file_state& f = files_[s.file];
+        if(s.offset == 0)
+            p.reset();
+        if(s.result < 0)
+        {
+            fail(f, std::strerror(static_cast<int>(-s.result)));
+        }
+        else if(! f.failed)
+        {
+            error_code ec;
+            p.write(s.buf.get(), static_cast<
+                std::size_t>(s.result), ec);
+            if(! ec && s.last)
+                p.finish(ec);
+            if(ec)
+            {
+                fail(f, ec.message());
+            }
+            else if(s.last)
+            {
+                value const jv = p.release();
+                (void)jv;
+                ++parsed;
+                bytes += f.size;
+            }
+        }
+        if(s.last && f.fd >= 0)
+        {
+            ::close(f.fd);
+            f.fd = -1;
+        }
+    }
+};
+
+int
+main(int argc, char** argv)
+{
+    std::size_t depth = 16;
+    std::size_t chunk = 256 * 1024;
+    unsigned threads = 4;
+    bool use_uring = true;
+    std::vector<char const*> paths;
+    for(int i = 1; i < argc; ++i)
+    {
+        std::string const arg = argv[i];
+        if(arg == "--depth" && i + 1 < argc)
+            depth = std::strtoul(argv[++i], nullptr, 10);
+        else if(arg == "--chunk" && i + 1 < argc)
+            chunk = std::strtoul(argv[++i], nullptr, 10) * 1024;
+        else if(arg == "--threads" && i + 1 < argc)
+            threads = static_cast<unsigned>(
+                std::strtoul(argv[++i], nullptr, 10));
+        else if(arg == "--no-uring")
+            use_uring = false;
+        else
+            paths.push_back(argv[i]);
+    }
+    if(paths.empty() || depth < 2 || chunk == 0 || threads == 0)
+    {
+        std::cerr <<
+            "Usage: ingest [--depth <chunks>] [--chunk <KiB>]\n"
+            "              [--threads <n>] [--no-uring] <filename>...\n";
+        return EXIT_FAILURE;
+    }
+
+    std::unique_ptr<io_backend> io;
+#ifdef EXAMPLE_HAS_IO_URING
+    if(use_uring)
+    {
+        std::unique_ptr<uring_backend> u(new uring_backend);
+        if(u->open(static_cast<unsigned>(depth)))
+            io = std::move(u);
+        else
+            std::cerr << "io_uring unavailable, using pread\n";
+    }
+#else
+    (void)use_uring;
+#endif
+    if(! io)
+        io.reset(new pread_backend(threads));
+
+    try
+    {
+        auto const t0 = std::chrono::steady_clock::now();
+        ingest job(*io, paths, depth, chunk);
+        job.run();
+        auto const t1 = std::chrono::steady_clock::now();
+        double const sec =
+            std::chrono::duration<double>(t1 - t0).count();
+        std::cout <<
+            job.parsed << " files parsed, " <<
+            job.failed << " failed, " <<
+            job.bytes << " bytes in " << sec << "s (" <<
+            (sec > 0 ? job.bytes / sec / 1e6 : 0) << " MB/s)\n";
+        return job.failed ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+    catch(std::exception const& e)
+    {
+        std::cerr <<
+            "Caught exception: "
+            << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+}
+
+#else
+
+int
+main()
+{
+    std::cerr << "ingest requires a POSIX system\n";
+    return EXIT_FAILURE;
+}
+
+#endif
+
+//]
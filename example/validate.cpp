@@ -82,7 +82,7 @@ public:
 };
 
 bool
-validate( string_view s )
+is_valid( string_view s )
 {
     // Parse with the null parser and return false on error
     null_parser p;
@@ -112,7 +112,7 @@ main(int argc, char** argv)
         auto const s = read_file( argv[1] );
 
         // See if the string is valid JSON
-        auto const valid = validate( s );
+        auto const valid = is_valid( s );
 
         // Print the result
         if( valid )
@@ -0,0 +1,216 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+// Copyright (c) 2020 Paul Dreik (github@pauldreik.se)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Searches for inputs which are slow to parse and
+// serialize, per byte, rather than for crashes.
+//
+// The cost of each input is compared with the cost per
+// byte of a typical document, measured at startup. The
+// ratio, bucketed by powers of two together with the size
+// of the input, is fed back to libFuzzer as extra coverage
+// counters, so that inputs reaching a higher cost for
+// their size are kept in the corpus and mutated further.
+// This steers the fuzzer towards deep nesting, long
+// escape sequences, colliding keys and any other input
+// whose cost grows faster than its length.
+//
+// Inputs costing more than BOOST_JSON_FUZZ_SLOW_FACTOR
+// times the typical cost per byte (20 by default) are
+// reported and saved to slow-<hash>.json.
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse_options.hpp>
+#include <boost/json/serializer.hpp>
+#include <boost/json/stream_parser.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using namespace boost::json;
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// Inputs shorter than this are dominated by the
+// fixed cost of a call, and are not measured.
+constexpr std::size_t min_size = 16;
+
+constexpr std::size_t cost_buckets = 32;
+constexpr std::size_t size_buckets = 16;
+
+// libFuzzer treats each nonzero byte in this
+// section as a feature of the current input.
+#if defined(__linux__)
+__attribute__((used, section("__libfuzzer_extra_counters")))
+#endif
+std::uint8_t
+extra_counters[cost_buckets * size_buckets];
+
+// Parses and serializes the input, returning
+// the number of bytes produced so that the
+// work cannot be optimized away.
+std::size_t
+run(string_view s)
+{
+    parse_options opt;
+    opt.max_depth = 100000;
+    monotonic_resource mr;
+    stream_parser p(storage_ptr(), opt);
+    p.reset(&mr);
+    error_code ec;
+    p.write(s, ec);
+    if(! ec)
+        p.finish(ec);
+    if(ec)
+        return 0;
+    value const jv = p.release();
+    serializer sr;
+    sr.reset(&jv);
+    char buf[4096];
+    std::size_t n = 0;
+    while(! sr.done())
+        n += sr.read(buf).size();
+    return n;
+}
+
+std::size_t volatile sink;
+
+// Returns the smallest of several timings of
+// `run`, in nanoseconds, to reduce the noise
+// from interrupts and frequency changes.
+double
+measure(string_view s)
+{
+    double best = 0;
+    for(int i = 0; i < 3; ++i)
+    {
+        auto const t0 = clock_type::now();
+        sink = run(s);
+        auto const t1 = clock_type::now();
+        double const t = std::chrono::duration<
+            double, std::nano>(t1 - t0).count();
+        if(i == 0 || t < best)
+            best = t;
+    }
+    return best;
+}
+
+struct baseline
+{
+    // cost of a call on an empty document
+    double fixed;
+
+    // cost per byte of a typical document
+    double per_byte;
+
+    double factor;
+
+    baseline()
+    {
+        std::string s = "[";
+        for(int i = 0; i < 500; ++i)
+        {
+            if(i > 0)
+                s += ',';
+            s += "{\"id\":" + std::to_string(i * 7919) +
+                ",\"name\":\"item " + std::to_string(i) +
+                "\",\"price\":12.75,\"tags\":[\"a\",\"b\"],"
+                "\"active\":true,\"parent\":null}";
+        }
+        s += ']';
+        for(int i = 0; i < 10; ++i)
+            sink = run(s);
+        fixed = measure("[]");
+        per_byte = (std::max)(1e-3,
+            (measure(s) - fixed) / s.size());
+        factor = 20;
+        if(char const* e = std::getenv(
+            "BOOST_JSON_FUZZ_SLOW_FACTOR"))
+            factor = std::atof(e);
+        std::fprintf(stderr,
+            "fuzz_slow: %.0f ns per call, %.2f ns per byte\n",
+            fixed, per_byte);
+    }
+};
+
+std::size_t
+log2_floor(double x)
+{
+    std::size_t n = 0;
+    while(x >= 2)
+    {
+        x /= 2;
+        ++n;
+    }
+    return n;
+}
+
+void
+save(
+    string_view s,
+    double ratio)
+{
+    // FNV-1a names the file after its contents
+    std::uint64_t h = 14695981039346656037ull;
+    for(char c : s)
+        h = (h ^ static_cast<unsigned char>(c)) *
+            1099511628211ull;
+    char name[64];
+    std::snprintf(name, sizeof(name),
+        "slow-%016llx.json",
+        static_cast<unsigned long long>(h));
+    std::fprintf(stderr,
+        "fuzz_slow: %zu bytes cost %.1f times the "
+        "typical cost per byte, saved to %s\n",
+        s.size(), ratio, name);
+    if(FILE* f = std::fopen(name, "wb"))
+    {
+        std::fwrite(s.data(), 1, s.size(), f);
+        std::fclose(f);
+    }
+}
+
+} // (anon)
+
+extern "C"
+int
+LLVMFuzzerTestOneInput(
+    const uint8_t* data, size_t size)
+{
+    static baseline const b;
+    if(size < min_size)
+        return 0;
+    string_view const s{reinterpret_cast<
+        const char*>(data), size};
+    try
+    {
+        double const t = measure(s);
+        double const ratio =
+            (std::max)(0.0, t - b.fixed) /
+            size / b.per_byte;
+        auto const cost = (std::min)(
+            log2_floor(ratio * 4), cost_buckets - 1);
+        auto const length = (std::min)(
+            log2_floor(static_cast<double>(
+                size / min_size)), size_buckets - 1);
+        extra_counters[length * cost_buckets + cost] = 1;
+        if(ratio > b.factor)
+            save(s, ratio);
+    }
+    catch(...)
+    {
+    }
+    return 0;
+}
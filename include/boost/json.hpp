@@ -13,19 +13,28 @@
 #include <boost/json/detail/config.hpp>
 
 #include <boost/json/array.hpp>
+#include <boost/json/async_parse.hpp>
 #include <boost/json/basic_parser.hpp>
 #include <boost/json/error.hpp>
 #include <boost/json/fwd.hpp>
+#include <boost/json/json_path.hpp>
+#include <boost/json/json_pointer.hpp>
+#include <boost/json/json_schema.hpp>
 #include <boost/json/kind.hpp>
 #include <boost/json/memory_resource.hpp>
+#include <boost/json/merge_patch.hpp>
 #include <boost/json/monotonic_resource.hpp>
 #include <boost/json/null_resource.hpp>
 #include <boost/json/object.hpp>
 #include <boost/json/parse.hpp>
 #include <boost/json/parse_options.hpp>
+#include <boost/json/parse_stats.hpp>
 #include <boost/json/parser.hpp>
+#include <boost/json/path_parser.hpp>
 #include <boost/json/pilfer.hpp>
+#include <boost/json/schema_parser.hpp>
 #include <boost/json/serialize.hpp>
+#include <boost/json/serialize_options.hpp>
 #include <boost/json/serializer.hpp>
 #include <boost/json/static_resource.hpp>
 #include <boost/json/storage_ptr.hpp>
@@ -33,6 +42,8 @@
 #include <boost/json/string.hpp>
 #include <boost/json/string_view.hpp>
 #include <boost/json/system_error.hpp>
+#include <boost/json/trace.hpp>
+#include <boost/json/validate.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/value_from.hpp>
 #include <boost/json/value_ref.hpp>
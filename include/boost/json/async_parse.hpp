@@ -0,0 +1,302 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_ASYNC_PARSE_HPP
+#define BOOST_JSON_ASYNC_PARSE_HPP
+
+#include <boost/json/detail/config.hpp>
+
+#if defined(__has_include)
+# if __has_include(<coroutine>) && defined(__cpp_impl_coroutine)
+#  define BOOST_JSON_HAS_COROUTINES
+# endif
+#endif
+
+#if defined(BOOST_JSON_HAS_COROUTINES) || defined(BOOST_JSON_DOCS)
+
+#include <boost/json/error.hpp>
+#include <boost/json/parse_options.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/stream_parser.hpp>
+#include <boost/json/string_view.hpp>
+#include <boost/json/value.hpp>
+#include <boost/json/detail/except.hpp>
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+
+namespace detail {
+
+// A lazily started coroutine producing a value,
+// which resumes its awaiter when it completes.
+class parse_task
+{
+public:
+    struct promise_type
+    {
+        // constructed by return_value, so the
+        // value keeps the caller's memory resource
+        std::optional<value> result;
+        std::exception_ptr ep;
+        std::coroutine_handle<> cont;
+
+        struct final_awaiter
+        {
+            bool
+            await_ready() const noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<>
+            await_suspend(
+                std::coroutine_handle<
+                    promise_type> h) noexcept
+            {
+                return h.promise().cont;
+            }
+
+            void
+            await_resume() const noexcept
+            {
+            }
+        };
+
+        parse_task
+        get_return_object() noexcept
+        {
+            return parse_task(std::coroutine_handle<
+                promise_type>::from_promise(*this));
+        }
+
+        std::suspend_always
+        initial_suspend() const noexcept
+        {
+            return {};
+        }
+
+        final_awaiter
+        final_suspend() const noexcept
+        {
+            return {};
+        }
+
+        void
+        return_value(value jv) noexcept
+        {
+            result.emplace(std::move(jv));
+        }
+
+        void
+        unhandled_exception() noexcept
+        {
+            ep = std::current_exception();
+        }
+    };
+
+    parse_task(parse_task&& other) noexcept
+        : h_(std::exchange(other.h_, nullptr))
+    {
+    }
+
+    parse_task& operator=(parse_task&&) = delete;
+
+    ~parse_task()
+    {
+        if(h_)
+            h_.destroy();
+    }
+
+    bool
+    await_ready() const noexcept
+    {
+        return false;
+    }
+
+    std::coroutine_handle<>
+    await_suspend(
+        std::coroutine_handle<> cont) noexcept
+    {
+        h_.promise().cont = cont;
+        return h_;
+    }
+
+    value
+    await_resume()
+    {
+        if(h_.promise().ep)
+            std::rethrow_exception(h_.promise().ep);
+        return std::move(*h_.promise().result);
+    }
+
+private:
+    std::coroutine_handle<promise_type> h_;
+
+    explicit
+    parse_task(
+        std::coroutine_handle<
+            promise_type> h) noexcept
+        : h_(h)
+    {
+    }
+};
+
+} // detail
+
+/** Asynchronously parse JSON read from a byte source.
+
+    This function returns an awaitable which, when
+    awaited from a coroutine, reads the serialized JSON
+    from `src` and produces the resulting @ref value.
+    Each chunk is obtained with `co_await src.read_some()`,
+    which must yield a type convertible to @ref string_view;
+    an empty view indicates the end of the input. Chunks are
+    parsed in place, so the source may return views into its
+    own buffers, which must remain valid until the next call
+    to `read_some`.
+\n
+    The operation completes as soon as a complete JSON has
+    been parsed and the chunk which contains its end has been
+    consumed, without waiting for the end of the input. A
+    number at the top level can only be completed by the end
+    of the input. The source is expected to yield a single
+    JSON: if a chunk contains characters past the end of the
+    JSON, other than whitespace, the error is
+    @ref error::extra_data and the rest of the chunk is
+    discarded. Sources carrying several documents must frame
+    them, or use @ref stream_parser directly.
+\n
+    If an error occurs, `ec` is set and the resulting value
+    is null, using the default memory resource. Exceptions
+    thrown by the source are propagated to the awaiter.
+
+    @par Example
+
+    @code
+    value jv = co_await async_parse( socket_source, ec );
+    @endcode
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to `memory_resource::allocate` may throw.
+
+    @return An awaitable producing the parsed @ref value.
+    The source, and `ec`, must remain valid until it
+    completes.
+
+    @param src The byte source to read from.
+
+    @param ec Set to the error, if any occurred.
+
+    @param sp The memory resource that the new value and all
+    of its elements will use. If this parameter is omitted,
+    the default memory resource is used.
+
+    @param opt The options for the parser. If this parameter
+    is omitted, the parser will accept only standard JSON.
+
+    @see
+        @ref parse,
+        @ref stream_parser.
+*/
+template<class Source>
+#ifdef BOOST_JSON_DOCS
+__see_below__
+#else
+detail::parse_task
+#endif
+async_parse(
+    Source& src,
+    error_code& ec,
+    storage_ptr sp = {},
+    parse_options opt = {})
+{
+    stream_parser p(storage_ptr(), opt);
+    p.reset(std::move(sp));
+    for(;;)
+    {
+        string_view const s =
+            co_await src.read_some();
+        if(s.empty())
+        {
+            p.finish(ec);
+            break;
+        }
+        auto const n = p.write_some(
+            s.data(), s.size(), ec);
+        if(ec)
+            break;
+        if(n < s.size())
+        {
+            ec = error::extra_data;
+            break;
+        }
+        if(p.done())
+            break;
+    }
+    if(ec)
+        co_return nullptr;
+    co_return p.release();
+}
+
+/** Asynchronously parse JSON read from a byte source.
+
+    This function returns an awaitable which, when
+    awaited from a coroutine, reads the serialized JSON
+    from `src` and produces the resulting @ref value,
+    as described in the overload which takes an
+    `error_code`. Errors are reported by throwing
+    `system_error` from the awaiting coroutine.
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to `memory_resource::allocate` may throw.
+
+    @return An awaitable producing the parsed @ref value.
+    The source must remain valid until it completes.
+
+    @param src The byte source to read from.
+
+    @param sp The memory resource that the new value and all
+    of its elements will use. If this parameter is omitted,
+    the default memory resource is used.
+
+    @param opt The options for the parser. If this parameter
+    is omitted, the parser will accept only standard JSON.
+
+    @throw system_error Thrown on failure.
+*/
+template<class Source>
+#ifdef BOOST_JSON_DOCS
+__see_below__
+#else
+detail::parse_task
+#endif
+async_parse(
+    Source& src,
+    storage_ptr sp = {},
+    parse_options opt = {})
+{
+    error_code ec;
+    value jv = co_await async_parse(
+        src, ec, std::move(sp), opt);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    co_return jv;
+}
+
+BOOST_JSON_NS_END
+
+#endif
+
+#endif
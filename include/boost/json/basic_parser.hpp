@@ -15,6 +15,7 @@
 #include <boost/json/error.hpp>
 #include <boost/json/kind.hpp>
 #include <boost/json/parse_options.hpp>
+#include <boost/json/parse_stats.hpp>
 #include <boost/json/detail/stack.hpp>
 #include <boost/json/detail/stream.hpp>
 #include <boost/json/detail/utf8.hpp>
@@ -317,6 +318,11 @@ class basic_parser
     parse_options opt_;
     // how many levels deeper the parser can go
     std::size_t depth_ = opt_.max_depth;
+#ifdef BOOST_JSON_PARSER_STATS
+    parse_stats stats_;
+
+    inline void count_suspend(state st) noexcept;
+#endif
     
     inline void reserve();
     inline const char* sentinel();
@@ -611,6 +617,48 @@ public:
         return done_;
     }
 
+#if defined(BOOST_JSON_PARSER_STATS) || defined(BOOST_JSON_DOCS)
+    /** Return the parsing statistics.
+
+        This function returns the counters which
+        describe the work done by the parser since
+        it was constructed, or since the last call
+        to @ref reset_stats. It is only available
+        when the macro `BOOST_JSON_PARSER_STATS`
+        is defined.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    parse_stats const&
+    stats() const noexcept
+    {
+        return stats_;
+    }
+
+    /** Reset the parsing statistics.
+
+        This function sets all of the counters
+        returned by @ref stats to zero. It is only
+        available when the macro
+        `BOOST_JSON_PARSER_STATS` is defined.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    void
+    reset_stats() noexcept
+    {
+        stats_ = parse_stats();
+    }
+#endif
+
     /** Reset the state, to parse a new document.
 
         This function discards the current parsing
@@ -29,6 +29,14 @@
     function template definitions for basic_parser.
 */
 
+// Updates the parse statistics, or expands
+// to nothing when they are not enabled.
+#ifdef BOOST_JSON_PARSER_STATS
+# define BOOST_JSON_PARSER_STAT(x) x
+#else
+# define BOOST_JSON_PARSER_STAT(x)
+#endif
+
 /*  Reference:
 
     https://www.json.org/
@@ -174,6 +182,40 @@ hex_digit(unsigned char c) noexcept
     return -1;
 }
 
+// Decode the four hexadecimal digits of a
+// utf-16 escape at once. Invalid digits map to
+// all ones, so any bad digit produces a result
+// which is greater than 0xFFFF.
+inline
+std::uint32_t
+hex_digits4(char const* p) noexcept
+{
+    constexpr std::uint32_t x = 0xFFFFFFFF;
+    static constexpr std::uint32_t tab[256] = {
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+        0x0, 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9,   x,   x,   x,   x,   x,   x,
+          x, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x, 0xa, 0xb, 0xc, 0xd, 0xe, 0xf,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+          x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,   x,
+    };
+    return
+        (tab[static_cast<unsigned char>(p[0])] << 12) |
+        (tab[static_cast<unsigned char>(p[1])] <<  8) |
+        (tab[static_cast<unsigned char>(p[2])] <<  4) |
+         tab[static_cast<unsigned char>(p[3])];
+}
+
 } // detail
 
 //----------------------------------------------------------
@@ -188,15 +230,84 @@ reserve()
         return;
     // Reserve the largest stack we need,
     // to avoid reallocation during suspend.
-    st_.reserve(
+    std::size_t const n =
         sizeof(state) + // document parsing state
         (sizeof(state) + 
             sizeof(std::size_t)) * depth() + // array and object state + size
         sizeof(state) + // value parsing state
         sizeof(std::size_t) + // string size
-        sizeof(state)); // comment state
+        sizeof(state); // comment state
+    BOOST_JSON_PARSER_STAT(
+        if(st_.capacity() < n)
+            ++stats_.stack_reallocations;)
+    st_.reserve(n);
 }
 
+#ifdef BOOST_JSON_PARSER_STATS
+template<class Handler>
+void
+basic_parser<Handler>::
+count_suspend(state st) noexcept
+{
+    // only the innermost state is counted, the
+    // enclosing ones are pushed on top of it
+    if(! st_.empty())
+        return;
+    parse_stats::site s;
+    switch(st)
+    {
+    case state::doc3:
+        // the document is complete, and the
+        // parser waits for trailing whitespace
+        return;
+    default:
+    case state::doc1: case state::doc2:
+    case state::doc4:
+        s = parse_stats::site::document;
+        break;
+    case state::com1: case state::com2:
+    case state::com3: case state::com4:
+        s = parse_stats::site::comment;
+        break;
+    case state::nul1: case state::nul2: case state::nul3:
+    case state::tru1: case state::tru2: case state::tru3:
+    case state::fal1: case state::fal2:
+    case state::fal3: case state::fal4:
+        s = parse_stats::site::literal;
+        break;
+    case state::str1: case state::str2: case state::str8:
+        s = parse_stats::site::string;
+        break;
+    case state::str3: case state::str4: case state::str5:
+    case state::str6: case state::str7:
+    case state::sur1: case state::sur2: case state::sur3:
+    case state::sur4: case state::sur5: case state::sur6:
+        s = parse_stats::site::escape;
+        break;
+    case state::obj1: case state::obj2: case state::obj3:
+    case state::obj4: case state::obj5: case state::obj6:
+    case state::obj7: case state::obj8: case state::obj9:
+    case state::obj10: case state::obj11:
+        s = parse_stats::site::object;
+        break;
+    case state::arr1: case state::arr2: case state::arr3:
+    case state::arr4: case state::arr5: case state::arr6:
+        s = parse_stats::site::array;
+        break;
+    case state::num1: case state::num2: case state::num3:
+    case state::num4: case state::num5: case state::num6:
+    case state::num7: case state::num8:
+    case state::exp1: case state::exp2: case state::exp3:
+        s = parse_stats::site::number;
+        break;
+    case state::val1: case state::val2:
+        s = parse_stats::site::value;
+        break;
+    }
+    ++stats_.suspensions_at(s);
+}
+#endif
+
 //----------------------------------------------------------
 //
 // The sentinel value is returned by parse functions
@@ -239,6 +350,7 @@ suspend_or_fail(state st)
     {
         // suspend
         reserve();
+        BOOST_JSON_PARSER_STAT(count_suspend(st));
         st_.push_unchecked(st);
     }
     return sentinel();
@@ -256,6 +368,7 @@ suspend_or_fail(
     {
         // suspend
         reserve();
+        BOOST_JSON_PARSER_STAT(count_suspend(st));
         st_.push_unchecked(n);
         st_.push_unchecked(st);
     }
@@ -296,6 +409,7 @@ maybe_suspend(
     {
         // suspend
         reserve();
+        BOOST_JSON_PARSER_STAT(count_suspend(st));
         st_.push_unchecked(st);
     }
     return sentinel();
@@ -314,6 +428,7 @@ maybe_suspend(
     {
         // suspend
         reserve();
+        BOOST_JSON_PARSER_STAT(count_suspend(st));
         st_.push_unchecked(n);
         st_.push_unchecked(st);
     }
@@ -334,6 +449,7 @@ maybe_suspend(
         // suspend
         num_ = num;
         reserve();
+        BOOST_JSON_PARSER_STAT(count_suspend(st));
         st_.push_unchecked(st);;
     }
     return sentinel();
@@ -349,6 +465,7 @@ suspend(
     end_ = p;
     // suspend
     reserve();
+    BOOST_JSON_PARSER_STAT(count_suspend(st));
     st_.push_unchecked(st);
     return sentinel();
 }
@@ -365,6 +482,7 @@ suspend(
     // suspend
     num_ = num;
     reserve();
+    BOOST_JSON_PARSER_STAT(count_suspend(st));
     st_.push_unchecked(st);
     return sentinel();
 }
@@ -425,6 +543,7 @@ do_com2:
                     return fail(cs.end());
                 return cs.end();
             }
+            BOOST_JSON_PARSER_STAT(++stats_.comment_parts);
             if(BOOST_JSON_UNLIKELY(! h_.on_comment_part(
                 {start, cs.remain(start)}, ec_)))
                 return fail(cs.end());
@@ -447,6 +566,7 @@ do_com3:
             // stopped inside a c comment
             if(BOOST_JSON_UNLIKELY(incomplete(cs)))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.comment_parts);
                 if(BOOST_JSON_UNLIKELY(! h_.on_comment_part(
                     {start, cs.remain(start)}, ec_)))
                     return fail(cs.end());
@@ -457,6 +577,7 @@ do_com3:
 do_com4:
             if(BOOST_JSON_UNLIKELY(! cs))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.comment_parts);
                 if(BOOST_JSON_UNLIKELY(! h_.on_comment_part(
                     {start, cs.used(start)}, ec_)))
                     return fail(cs.begin());
@@ -986,6 +1107,7 @@ parse_unescaped(const char* p,
         if(BOOST_JSON_LIKELY(size))
         {
             {
+                BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                 bool r = is_key?
                     h_.on_key_part( {start, size}, total, ec_ ):
                     h_.on_string_part( {start, size}, total, ec_ );
@@ -1009,6 +1131,7 @@ parse_unescaped(const char* p,
             if(BOOST_JSON_LIKELY(size))
             {
                 {
+                    BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                     bool r = is_key?
                         h_.on_key_part( {start, size}, total, ec_ ):
                         h_.on_string_part( {start, size}, total, ec_ );
@@ -1027,6 +1150,7 @@ parse_unescaped(const char* p,
             if(BOOST_JSON_LIKELY(size))
             {
                 {
+                    BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                     bool r = is_key?
                         h_.on_key_part( {start, size}, total, ec_ ):
                         h_.on_string_part( {start, size}, total, ec_ );
@@ -1135,6 +1259,7 @@ do_str3:
                 return fail(cs.begin(), ev_too_large);
             total += temp.size();
             {
+                BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                 bool r = is_key? h_.on_key_part(temp, total, ec_): h_.on_string_part(temp, total, ec_);
 
                 if(BOOST_JSON_UNLIKELY(!r))
@@ -1148,6 +1273,7 @@ do_str3:
         if(BOOST_JSON_UNLIKELY(! cs))
             return maybe_suspend(cs.begin(), state::str3, total);
     }
+    BOOST_JSON_PARSER_STAT(++stats_.escapes);
     switch(*cs)
     {
     default:
@@ -1191,34 +1317,17 @@ do_str3:
         // is large enough for 2 surrogates
         if(BOOST_JSON_LIKELY(cs.remain() > 10))
         {
-            // KRYSTIAN TODO: this could be done
-            // with fewer instructions
-            digit = detail::load_little_endian<4>(
-                cs.begin() + 1);
-            int d4 = detail::hex_digit(static_cast<
-                unsigned char>(digit >> 24));
-            int d3 = detail::hex_digit(static_cast<
-                unsigned char>(digit >> 16));
-            int d2 = detail::hex_digit(static_cast<
-                unsigned char>(digit >> 8));
-            int d1 = detail::hex_digit(static_cast<
-                unsigned char>(digit));
-            if(BOOST_JSON_UNLIKELY(
-                (d1 | d2 | d3 | d4) == -1))
+            ++cs;
+            // 32 bit unicode scalar value
+            unsigned const u1 =
+                detail::hex_digits4(cs.begin());
+            if(BOOST_JSON_UNLIKELY(u1 > 0xffff))
             {
-                if(d1 != -1)
+                while(detail::hex_digit(*cs) != -1)
                     ++cs;
-                if(d2 != -1)
-                    ++cs;
-                if(d3 != -1)
-                    ++cs;
-                return fail(cs.begin(), 
+                return fail(cs.begin(),
                     error::expected_hex_digit);
             }
-            // 32 bit unicode scalar value
-            unsigned const u1 =
-                (d1 << 12) + (d2 << 8) +
-                (d3 << 4) + d4;
             // valid unicode scalar values are
             // [0, D7FF] and [E000, 10FFFF]
             // values within this range are valid utf-8
@@ -1226,51 +1335,33 @@ do_str3:
             if(BOOST_JSON_LIKELY(
                 u1 < 0xd800 || u1 > 0xdfff))
             {
-                cs += 5;
+                cs += 4;
                 temp.append_utf8(u1);
                 break;
             }
             if(BOOST_JSON_UNLIKELY(u1 > 0xdbff))
-                return fail(cs.begin(), 
+                return fail(cs.begin() - 1,
                     error::illegal_leading_surrogate);
-            cs += 5;
-            // KRYSTIAN TODO: this can be a two byte load
-            // and a single comparison. We lose error information,
-            // but it's faster.
+            cs += 4;
             if(BOOST_JSON_UNLIKELY(*cs != '\\'))
                 return fail(cs.begin(), error::syntax);
             ++cs;
             if(BOOST_JSON_UNLIKELY(*cs != 'u'))
                 return fail(cs.begin(), error::syntax);
             ++cs;
-            digit = detail::load_little_endian<4>(cs.begin());
-            d4 = detail::hex_digit(static_cast<
-                unsigned char>(digit >> 24));
-            d3 = detail::hex_digit(static_cast<
-                unsigned char>(digit >> 16));
-            d2 = detail::hex_digit(static_cast<
-                unsigned char>(digit >> 8));
-            d1 = detail::hex_digit(static_cast<
-                unsigned char>(digit));
-            if(BOOST_JSON_UNLIKELY(
-                (d1 | d2 | d3 | d4) == -1))
+            unsigned const u2 =
+                detail::hex_digits4(cs.begin());
+            if(BOOST_JSON_UNLIKELY(u2 > 0xffff))
             {
-                if(d1 != -1)
-                    ++cs;
-                if(d2 != -1)
+                while(detail::hex_digit(*cs) != -1)
                     ++cs;
-                if(d3 != -1)
-                    ++cs;
-                return fail(cs.begin(), 
+                return fail(cs.begin(),
                     error::expected_hex_digit);
             }
-            unsigned const u2 =
-                (d1 << 12) + (d2 << 8) +
-                (d3 << 4) + d4;
             // valid trailing surrogates are [DC00, DFFF]
             if(BOOST_JSON_UNLIKELY(
                 u2 < 0xdc00 || u2 > 0xdfff))
-                return fail(cs.begin(), 
+                return fail(cs.begin(),
                     error::illegal_trailing_surrogate);
             cs += 4;
             unsigned cp =
@@ -1290,6 +1381,7 @@ do_str3:
                 return fail(cs.begin(), ev_too_large);
             total += temp.size();
             {
+                BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                 bool r = is_key? h_.on_key_part(temp, total, ec_): h_.on_string_part(temp, total, ec_);
 
                 if(BOOST_JSON_UNLIKELY(!r))
@@ -1410,8 +1502,6 @@ do_sur6:
         temp.append_utf8(cp);
     }
 do_str2:
-    // KRYSTIAN TODO: we can append the characters
-    // all at once instead of one at a time
     for(;;)
     {
         if(BOOST_JSON_UNLIKELY(! cs))
@@ -1425,6 +1515,7 @@ do_str2:
                     return fail(cs.begin(), ev_too_large);
                 total += temp.size();
                 {
+                    BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                     bool r = is_key? h_.on_key_part(temp, total, ec_): h_.on_string_part(temp, total, ec_);
 
                     if(BOOST_JSON_UNLIKELY(!r))
@@ -1438,6 +1529,18 @@ do_str2:
             if(BOOST_JSON_UNLIKELY(! cs))
                 return maybe_suspend(cs.begin(), state::str2, total);
         }
+        // copy the run of characters which need
+        // no special handling all at once, the
+        // clipped input always fits in the buffer
+        {
+            char const* const start = cs.begin();
+            cs = allow_bad_utf8?
+                detail::count_valid<true>(start, cs.end()):
+                detail::count_valid<false>(start, cs.end());
+            temp.append(start, cs.used(start));
+            if(BOOST_JSON_UNLIKELY(! cs))
+                continue;
+        }
         c = *cs;
         if(BOOST_JSON_LIKELY(c == '\x22')) // '"'
         {
@@ -1470,6 +1573,7 @@ do_str2:
                         return fail(cs.begin(), ev_too_large);
                     total += temp.size();
                     {
+                        BOOST_JSON_PARSER_STAT(++stats_.string_parts);
                         bool r = is_key? h_.on_key_part(temp, total, ec_): h_.on_string_part(temp, total, ec_);
 
                         if(BOOST_JSON_UNLIKELY(!r))
@@ -1495,11 +1599,9 @@ do_str2:
             ++cs;
             goto do_str3;
         }
-        else if(BOOST_JSON_UNLIKELY(
-            detail::is_control(c)))
-            return fail(cs.begin(), error::syntax);
-        temp.push_back(c);
-        ++cs;
+        // illegal control
+        BOOST_ASSERT(detail::is_control(c));
+        return fail(cs.begin(), error::syntax);
     }
 do_str8:
     uint8_t needed = seq_.needed();
@@ -1558,6 +1660,9 @@ parse_object(const char* p,
     if(BOOST_JSON_UNLIKELY(! depth_))
         return fail(cs.begin(), error::too_deep);
     --depth_;
+    BOOST_JSON_PARSER_STAT(
+        if(depth() > stats_.max_depth)
+            stats_.max_depth = depth();)
     if(BOOST_JSON_UNLIKELY(
         ! h_.on_object_begin(ec_)))
         return fail(cs.begin());
@@ -1706,6 +1811,9 @@ parse_array(const char* p,
     if(BOOST_JSON_UNLIKELY(! depth_))
         return fail(cs.begin(), error::too_deep);
     --depth_;
+    BOOST_JSON_PARSER_STAT(
+        if(depth() > stats_.max_depth)
+            stats_.max_depth = depth();)
     if(BOOST_JSON_UNLIKELY(
         ! h_.on_array_begin(ec_)))
         return fail(cs.begin());
@@ -1838,6 +1946,7 @@ parse_number(const char* p,
                 // >= 16 leading digits
                 if( n1 == 16 )
                 {
+                    BOOST_JSON_PARSER_STAT(++stats_.slow_numbers);
                     goto do_num2;
                 }
             }
@@ -1880,6 +1989,7 @@ parse_number(const char* p,
             // floating-point mantissa overflow
             if( n1 + n2 >= 19 )
             {
+                BOOST_JSON_PARSER_STAT(++stats_.slow_numbers);
                 goto do_num7;
             }
 
@@ -1900,11 +2010,13 @@ parse_number(const char* p,
             }
             else if( ch >= '0' && ch <= '9' )
             {
+                BOOST_JSON_PARSER_STAT(++stats_.slow_numbers);
                 goto do_num8;
             }
 
             goto finish_dub;
         }
+        BOOST_JSON_PARSER_STAT(++stats_.slow_numbers);
     }
     else
     {
@@ -1964,6 +2076,7 @@ do_num1:
     }
     else
     {
+        BOOST_JSON_PARSER_STAT(++stats_.number_parts);
         if(BOOST_JSON_UNLIKELY(
             ! h_.on_number_part(
                 {begin, cs.used(begin)}, ec_)))
@@ -1986,6 +2099,7 @@ do_num2:
             {
                 if(BOOST_JSON_UNLIKELY(more_))
                 {
+                    BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                     if(BOOST_JSON_UNLIKELY(
                         ! h_.on_number_part(
                             {begin, cs.used(begin)}, ec_)))
@@ -2017,6 +2131,7 @@ do_num2:
             {
                 if(BOOST_JSON_UNLIKELY(more_))
                 {
+                    BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                     if(BOOST_JSON_UNLIKELY(
                         ! h_.on_number_part(
                             {begin, cs.used(begin)}, ec_)))
@@ -2056,6 +2171,7 @@ do_num3:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2099,6 +2215,7 @@ do_num4:
     {
         if(BOOST_JSON_UNLIKELY(! cs))
         {
+            BOOST_JSON_PARSER_STAT(++stats_.number_parts);
             if(BOOST_JSON_UNLIKELY(
                 ! h_.on_number_part(
                     {begin, cs.used(begin)}, ec_)))
@@ -2133,6 +2250,7 @@ do_num5:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2168,6 +2286,7 @@ do_num6:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2205,6 +2324,7 @@ do_num7:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2236,6 +2356,7 @@ do_num8:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2278,6 +2399,7 @@ do_num8:
 do_exp1:
     if(BOOST_JSON_UNLIKELY(! cs))
     {
+        BOOST_JSON_PARSER_STAT(++stats_.number_parts);
         if(BOOST_JSON_UNLIKELY(
             ! h_.on_number_part(
                 {begin, cs.used(begin)}, ec_)))
@@ -2306,6 +2428,7 @@ do_exp2:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2338,6 +2461,7 @@ do_exp3:
         {
             if(BOOST_JSON_UNLIKELY(more_))
             {
+                BOOST_JSON_PARSER_STAT(++stats_.number_parts);
                 if(BOOST_JSON_UNLIKELY(
                     ! h_.on_number_part(
                         {begin, cs.used(begin)}, ec_)))
@@ -2530,6 +2654,8 @@ write_some(
 
 BOOST_JSON_NS_END
 
+#undef BOOST_JSON_PARSER_STAT
+
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif
@@ -0,0 +1,65 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_BUFFERS_HPP
+#define BOOST_JSON_DETAIL_BUFFERS_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/string_view.hpp>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+// A buffer sequence is a range whose elements are
+// either convertible to string_view, or contiguous
+// byte ranges with data() and size().
+template<class T, class = void>
+struct is_buffer_sequence : std::false_type
+{
+};
+
+template<class T>
+struct is_buffer_sequence<T, void_t<
+    decltype(std::begin(std::declval<T const&>())),
+    decltype(std::end(std::declval<T const&>()))
+        >> : std::integral_constant<bool,
+            ! std::is_convertible<
+                T const&, string_view>::value>
+{
+};
+
+template<class Buffer>
+typename std::enable_if<
+    std::is_convertible<
+        Buffer const&, string_view>::value,
+    string_view>::type
+buffer_view(Buffer const& b) noexcept
+{
+    return b;
+}
+
+template<class Buffer>
+typename std::enable_if<
+    ! std::is_convertible<
+        Buffer const&, string_view>::value,
+    string_view>::type
+buffer_view(Buffer const& b) noexcept
+{
+    return { static_cast<char const*>(
+        static_cast<void const*>(b.data())),
+        b.size() };
+}
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
@@ -134,6 +134,21 @@
 # endif
 #endif
 
+#if ! defined(BOOST_JSON_NO_SSSE3) && \
+    ! defined(BOOST_JSON_USE_SSSE3)
+# if defined(BOOST_JSON_USE_SSE2) && \
+      (defined(__SSSE3__) || defined(__AVX__))
+#  define BOOST_JSON_USE_SSSE3
+# endif
+#endif
+
+#if ! defined(BOOST_JSON_NO_MMAP) && \
+    ! defined(BOOST_JSON_HAS_MMAP)
+# if defined(__unix__) || defined(__APPLE__)
+#  define BOOST_JSON_HAS_MMAP
+# endif
+#endif
+
 #ifndef BOOST_SYMBOL_VISIBLE
 #define BOOST_SYMBOL_VISIBLE
 #endif
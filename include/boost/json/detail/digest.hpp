@@ -13,6 +13,48 @@
 BOOST_JSON_NS_BEGIN
 namespace detail {
 
+// Calculate unsalted digest of string
+inline
+std::size_t
+digest(
+    char const* s,
+    std::size_t n) noexcept
+{
+#if BOOST_JSON_ARCH == 64
+    std::uint64_t const prime = 0x100000001B3ULL;
+    std::uint64_t hash  = 0xcbf29ce484222325ULL;
+#else
+    std::uint32_t const prime = 0x01000193UL;
+    std::uint32_t hash  = 0x811C9DC5UL;
+#endif
+    for(;n--;++s)
+        hash = (*s ^ hash) * prime;
+    return hash;
+}
+
+// Mix a digest with a salt. This is used
+// to combine digests of the parts of a value.
+inline
+std::size_t
+salt_digest(
+    std::size_t hash,
+    std::size_t salt) noexcept
+{
+#if BOOST_JSON_ARCH == 64
+    std::uint64_t h = hash + salt;
+    h = (h ^ (h >> 33)) * 0xff51afd7ed558ccdULL;
+    h = (h ^ (h >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+#else
+    std::uint32_t h = static_cast<
+        std::uint32_t>(hash + salt);
+    h = (h ^ (h >> 16)) * 0x85ebca6bUL;
+    h = (h ^ (h >> 13)) * 0xc2b2ae35UL;
+    h ^= h >> 16;
+#endif
+    return static_cast<std::size_t>(h);
+}
+
 // Calculate salted digest of string
 inline
 std::size_t
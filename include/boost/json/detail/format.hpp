@@ -36,6 +36,14 @@ unsigned
 format_double(
     char* dest, double d) noexcept;
 
+// Format as ECMAScript's Number.prototype.toString,
+// which RFC 8785 requires. Infinity and NaN, which
+// have no JSON representation, are formatted as null.
+BOOST_JSON_DECL
+unsigned
+format_double_canonical(
+    char* dest, double d) noexcept;
+
 } // detail
 BOOST_JSON_NS_END
 
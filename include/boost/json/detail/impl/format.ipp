@@ -117,6 +117,79 @@ format_double(
         ryu::d2s_buffered_n(d, dest));
 }
 
+unsigned
+format_double_canonical(
+    char* dest, double d) noexcept
+{
+    std::uint64_t m;
+    std::int32_t e;
+    if(! ryu::d2d_shortest(d, m, e))
+    {
+        if(d == 0)
+        {
+            // includes negative zero
+            *dest = '0';
+            return 1;
+        }
+        std::memcpy(dest, "null", 4);
+        return 4;
+    }
+    char* p = dest;
+    if(d < 0)
+        *p++ = '-';
+    char digits[24];
+    int const k = static_cast<int>(
+        format_uint64(digits, m));
+    // the value is 0.digits * 10^n
+    int const n = e + k;
+    if(k <= n && n <= 21)
+    {
+        std::memcpy(p, digits, k);
+        p += k;
+        std::memset(p, '0', n - k);
+        p += n - k;
+    }
+    else if(0 < n && n <= 21)
+    {
+        std::memcpy(p, digits, n);
+        p += n;
+        *p++ = '.';
+        std::memcpy(p, digits + n, k - n);
+        p += k - n;
+    }
+    else if(-6 < n && n <= 0)
+    {
+        *p++ = '0';
+        *p++ = '.';
+        std::memset(p, '0', -n);
+        p += -n;
+        std::memcpy(p, digits, k);
+        p += k;
+    }
+    else
+    {
+        *p++ = digits[0];
+        if(k > 1)
+        {
+            *p++ = '.';
+            std::memcpy(p, digits + 1, k - 1);
+            p += k - 1;
+        }
+        *p++ = 'e';
+        if(n - 1 < 0)
+        {
+            *p++ = '-';
+            p += format_uint64(p, 1 - n);
+        }
+        else
+        {
+            *p++ = '+';
+            p += format_uint64(p, n - 1);
+        }
+    }
+    return static_cast<unsigned>(p - dest);
+}
+
 } // detail
 BOOST_JSON_NS_END
 
@@ -0,0 +1,130 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_IMPL_MAPPED_FILE_IPP
+#define BOOST_JSON_DETAIL_IMPL_MAPPED_FILE_IPP
+
+#include <boost/json/detail/mapped_file.hpp>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#ifdef BOOST_JSON_HAS_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+mapped_file::
+~mapped_file()
+{
+#ifdef BOOST_JSON_HAS_MMAP
+    if(mapped_)
+    {
+        ::munmap(data_, size_);
+        return;
+    }
+#endif
+    delete[] data_;
+}
+
+void
+mapped_file::
+open(
+    char const* path,
+    error_code& ec)
+{
+    BOOST_ASSERT(! data_);
+    auto const fail = [&ec](int ev)
+    {
+        ec = error_code(ev,
+            generic_category());
+    };
+
+#ifdef BOOST_JSON_HAS_MMAP
+    int const fd = ::open(path, O_RDONLY);
+    if(fd == -1)
+        return fail(errno);
+    struct stat st;
+    if(::fstat(fd, &st) == -1)
+    {
+        // close can change errno
+        int const ev = errno;
+        ::close(fd);
+        return fail(ev);
+    }
+    // Regular files are mapped. Anything else
+    // is read below, as is a file which reports
+    // no size, like those in /proc, or which
+    // cannot be mapped.
+    std::size_t const n =
+        static_cast<std::size_t>(st.st_size);
+    if(S_ISREG(st.st_mode) && n > 0)
+    {
+        void* const p = ::mmap(nullptr, n,
+            PROT_READ, MAP_PRIVATE, fd, 0);
+        if(p != MAP_FAILED)
+        {
+            ::close(fd);
+        #ifdef MADV_SEQUENTIAL
+            // the parser reads front to back once
+            ::madvise(p, n, MADV_SEQUENTIAL);
+        #endif
+            data_ = static_cast<char*>(p);
+            size_ = n;
+            mapped_ = true;
+            ec = {};
+            return;
+        }
+    }
+    ::close(fd);
+#endif
+
+    std::FILE* f = std::fopen(path, "rb");
+    if(! f)
+        return fail(errno);
+    std::size_t cap = 0;
+    for(;;)
+    {
+        if(size_ == cap)
+        {
+            std::size_t const n =
+                cap ? cap * 2 : 65536;
+            char* const p = new char[n];
+            if(data_)
+                std::memcpy(p, data_, size_);
+            delete[] data_;
+            data_ = p;
+            cap = n;
+        }
+        auto const n = std::fread(
+            data_ + size_, 1, cap - size_, f);
+        size_ += n;
+        if(n == 0)
+            break;
+    }
+    bool const bad = std::ferror(f) != 0;
+    std::fclose(f);
+    if(bad)
+    {
+        ec = error_code(EIO,
+            generic_category());
+        return;
+    }
+    ec = {};
+}
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
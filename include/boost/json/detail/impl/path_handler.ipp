@@ -0,0 +1,426 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_IMPL_PATH_HANDLER_IPP
+#define BOOST_JSON_DETAIL_IMPL_PATH_HANDLER_IPP
+
+#include <boost/json/detail/path_handler.hpp>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+/*  The handler keeps the automaton mask of each open
+    container. Outside of a match, only keys are copied
+    and only when they are split or the container can
+    still lead to a match. When a value begins whose
+    mask contains the accepting state, its events are
+    forwarded to a value_stack until it is complete.
+    Matches nested in it are then found by running the
+    automaton over the finished value.
+*/
+
+path_handler::
+path_handler(
+    json_path const& jp,
+    storage_ptr sp)
+    : path(jp)
+    , matches(sp)
+    , st(sp)
+    , key(sp)
+{
+}
+
+void
+path_handler::
+reset() noexcept
+{
+    frames.clear();
+    depth = 0;
+    top = {};
+    next = 0;
+    nest = 0;
+    building = false;
+    partial = false;
+    record = false;
+    key.clear();
+}
+
+auto
+path_handler::
+begin_value() noexcept ->
+    mask_type
+{
+    if(depth == 0)
+        return path.start();
+    if(! top.is_array)
+        return next;
+    if(! top.mask)
+        return 0;
+    return path.step(top.mask, top.index++);
+}
+
+bool
+path_handler::
+begin_scalar()
+{
+    if(building)
+        return true;
+    auto const m = begin_value();
+    if(! (m & path.accept()))
+        return false;
+    st.reset(matches.storage());
+    match = m;
+    building = true;
+    return true;
+}
+
+void
+path_handler::
+end_scalar()
+{
+    if(building && nest == 0)
+        finish_match();
+}
+
+bool
+path_handler::
+begin_container(bool is_array)
+{
+    if(building)
+    {
+        ++nest;
+        return true;
+    }
+    auto const m = begin_value();
+    if(m & path.accept())
+    {
+        st.reset(matches.storage());
+        match = m;
+        building = true;
+        nest = 1;
+        return true;
+    }
+    push_frame(m, is_array);
+    return false;
+}
+
+void
+path_handler::
+end_container()
+{
+    BOOST_ASSERT(depth > 0);
+    if(--depth > 0)
+        frames.pop(top);
+}
+
+void
+path_handler::
+push_frame(
+    mask_type m,
+    bool is_array)
+{
+    if(depth > 0)
+    {
+        if(depth > cap)
+        {
+            cap = depth * 2;
+            frames.reserve(cap * sizeof(frame));
+        }
+        frames.push_unchecked(top);
+    }
+    top = { m, 0, is_array };
+    ++depth;
+}
+
+void
+path_handler::
+finish_match()
+{
+    value v = st.release();
+    building = false;
+    if(! (match & ~path.accept()))
+    {
+        matches.push_back(std::move(v));
+        return;
+    }
+    // The automaton can still advance inside
+    // the match, so the value goes first, followed
+    // by copies of the matches nested within it.
+    auto const pos = matches.size();
+    matches.emplace_back(nullptr);
+    path.select_impl(v,
+        match & ~path.accept(), matches);
+    matches[pos] = std::move(v);
+}
+
+//----------------------------------------------------------
+
+bool
+path_handler::
+on_document_begin(
+    error_code&)
+{
+    reset();
+    return true;
+}
+
+bool
+path_handler::
+on_document_end(
+    error_code&)
+{
+    return true;
+}
+
+bool
+path_handler::
+on_object_begin(
+    error_code&)
+{
+    begin_container(false);
+    return true;
+}
+
+bool
+path_handler::
+on_object_end(
+    std::size_t n,
+    error_code&)
+{
+    if(! building)
+    {
+        end_container();
+        return true;
+    }
+    st.push_object(n);
+    if(--nest == 0)
+        finish_match();
+    return true;
+}
+
+bool
+path_handler::
+on_array_begin(
+    error_code&)
+{
+    begin_container(true);
+    return true;
+}
+
+bool
+path_handler::
+on_array_end(
+    std::size_t n,
+    error_code&)
+{
+    if(! building)
+    {
+        end_container();
+        return true;
+    }
+    st.push_array(n);
+    if(--nest == 0)
+        finish_match();
+    return true;
+}
+
+bool
+path_handler::
+on_key_part(
+    string_view s,
+    std::size_t,
+    error_code&)
+{
+    if(building)
+        st.push_chars(s);
+    else if(top.mask)
+        key.append(s);
+    return true;
+}
+
+bool
+path_handler::
+on_key(
+    string_view s,
+    std::size_t,
+    error_code&)
+{
+    if(building)
+    {
+        st.push_key(s);
+        return true;
+    }
+    if(! top.mask)
+    {
+        next = 0;
+        return true;
+    }
+    if(key.empty())
+    {
+        next = path.step(top.mask, s);
+        return true;
+    }
+    key.append(s);
+    next = path.step(top.mask, key);
+    key.clear();
+    return true;
+}
+
+bool
+path_handler::
+on_string_part(
+    string_view s,
+    std::size_t,
+    error_code&)
+{
+    if(! partial)
+    {
+        partial = true;
+        record = begin_scalar();
+    }
+    if(record)
+        st.push_chars(s);
+    return true;
+}
+
+bool
+path_handler::
+on_string(
+    string_view s,
+    std::size_t,
+    error_code&)
+{
+    if(! partial)
+        record = begin_scalar();
+    partial = false;
+    if(record)
+    {
+        st.push_string(s);
+        end_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_number_part(
+    string_view,
+    error_code&)
+{
+    if(! partial)
+    {
+        partial = true;
+        record = begin_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_int64(
+    std::int64_t i,
+    string_view,
+    error_code&)
+{
+    if(! partial)
+        record = begin_scalar();
+    partial = false;
+    if(record)
+    {
+        st.push_int64(i);
+        end_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_uint64(
+    std::uint64_t u,
+    string_view,
+    error_code&)
+{
+    if(! partial)
+        record = begin_scalar();
+    partial = false;
+    if(record)
+    {
+        st.push_uint64(u);
+        end_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_double(
+    double d,
+    string_view,
+    error_code&)
+{
+    if(! partial)
+        record = begin_scalar();
+    partial = false;
+    if(record)
+    {
+        st.push_double(d);
+        end_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_bool(
+    bool b,
+    error_code&)
+{
+    if(begin_scalar())
+    {
+        st.push_bool(b);
+        end_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_null(error_code&)
+{
+    if(begin_scalar())
+    {
+        st.push_null();
+        end_scalar();
+    }
+    return true;
+}
+
+bool
+path_handler::
+on_comment_part(
+    string_view,
+    error_code&)
+{
+    return true;
+}
+
+bool
+path_handler::
+on_comment(
+    string_view,
+    error_code&)
+{
+    return true;
+}
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
@@ -0,0 +1,440 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_IMPL_SCHEMA_HANDLER_IPP
+#define BOOST_JSON_DETAIL_IMPL_SCHEMA_HANDLER_IPP
+
+#include <boost/json/detail/schema_handler.hpp>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+/*  The handler keeps the schema node of each open
+    container. Types, ranges and string lengths are
+    checked when a value begins or as its parts
+    arrive, names are checked as soon as the key is
+    complete, and sizes and required properties when
+    the container ends. The `seen` mask of an object
+    has bit `i` set once its i-th required property
+    has appeared. Values under an unconstrained node
+    are only forwarded.
+*/
+
+schema_handler::
+schema_handler(
+    json_schema const& js,
+    storage_ptr sp)
+    : h(sp)
+    , schema(js)
+    , key(std::move(sp))
+{
+}
+
+void
+schema_handler::
+reset() noexcept
+{
+    frames.clear();
+    depth = 0;
+    top = {};
+    next = 0;
+    partial = false;
+    key.clear();
+}
+
+std::size_t
+schema_handler::
+begin_value() const noexcept
+{
+    if(depth == 0)
+        return schema.root();
+    if(! top.is_array)
+        return next;
+    if(top.node == json_schema::any)
+        return json_schema::any;
+    return schema.at(top.node).items;
+}
+
+bool
+schema_handler::
+check_type(
+    std::size_t i,
+    unsigned t,
+    error_code& ec) const noexcept
+{
+    if( i == json_schema::any ||
+        (schema.at(i).types & t))
+        return true;
+    ec = error::type_mismatch;
+    return false;
+}
+
+bool
+schema_handler::
+check_number(
+    json_schema::bound const& b,
+    error_code& ec) const noexcept
+{
+    auto const i = begin_value();
+    if(i == json_schema::any)
+        return true;
+    return schema.at(i).check_number(b, ec);
+}
+
+bool
+schema_handler::
+check_length(error_code& ec) const noexcept
+{
+    if(len <= schema.at(cur).max_length)
+        return true;
+    ec = error::size_out_of_range;
+    return false;
+}
+
+bool
+schema_handler::
+begin_container(
+    bool is_array,
+    error_code& ec)
+{
+    auto const i = begin_value();
+    if(! check_type(i, is_array ?
+            json_schema::array_type :
+            json_schema::object_type, ec))
+        return false;
+    if(depth > 0)
+    {
+        if(depth > cap)
+        {
+            cap = depth * 2;
+            frames.reserve(cap * sizeof(frame));
+        }
+        frames.push_unchecked(top);
+    }
+    top = { i, 0, is_array };
+    ++depth;
+    return true;
+}
+
+bool
+schema_handler::
+end_container(
+    std::size_t n,
+    error_code& ec)
+{
+    BOOST_ASSERT(depth > 0);
+    if(top.node != json_schema::any)
+    {
+        node const& nd = schema.at(top.node);
+        if(top.is_array)
+        {
+            if(n < nd.min_items || n > nd.max_items)
+            {
+                ec = error::size_out_of_range;
+                return false;
+            }
+        }
+        else
+        {
+            if(nd.nrequired && top.seen != (
+                ~std::uint64_t(0) >> (64 - nd.nrequired)))
+            {
+                ec = error::required_missing;
+                return false;
+            }
+            if(n < nd.min_props || n > nd.max_props)
+            {
+                ec = error::size_out_of_range;
+                return false;
+            }
+        }
+    }
+    if(--depth > 0)
+        frames.pop(top);
+    return true;
+}
+
+bool
+schema_handler::
+on_name(
+    string_view s,
+    error_code& ec) noexcept
+{
+    node const& nd = schema.at(top.node);
+    auto const p = schema.find(nd, s);
+    if(p)
+    {
+        next = p->schema;
+        if(p->bit != json_schema::any)
+            top.seen |= std::uint64_t(1) << p->bit;
+        return true;
+    }
+    if(schema.rejects(nd.additional))
+    {
+        ec = error::additional_property;
+        return false;
+    }
+    next = nd.additional;
+    return true;
+}
+
+//----------------------------------------------------------
+
+bool
+schema_handler::
+on_document_begin(
+    error_code& ec)
+{
+    reset();
+    return h.on_document_begin(ec);
+}
+
+bool
+schema_handler::
+on_document_end(
+    error_code& ec)
+{
+    return h.on_document_end(ec);
+}
+
+bool
+schema_handler::
+on_object_begin(
+    error_code& ec)
+{
+    return
+        begin_container(false, ec) &&
+        h.on_object_begin(ec);
+}
+
+bool
+schema_handler::
+on_object_end(
+    std::size_t n,
+    error_code& ec)
+{
+    return
+        end_container(n, ec) &&
+        h.on_object_end(n, ec);
+}
+
+bool
+schema_handler::
+on_array_begin(
+    error_code& ec)
+{
+    return
+        begin_container(true, ec) &&
+        h.on_array_begin(ec);
+}
+
+bool
+schema_handler::
+on_array_end(
+    std::size_t n,
+    error_code& ec)
+{
+    return
+        end_container(n, ec) &&
+        h.on_array_end(n, ec);
+}
+
+bool
+schema_handler::
+on_key_part(
+    string_view s,
+    std::size_t n,
+    error_code& ec)
+{
+    if(top.node != json_schema::any)
+        key.append(s);
+    return h.on_key_part(s, n, ec);
+}
+
+bool
+schema_handler::
+on_key(
+    string_view s,
+    std::size_t n,
+    error_code& ec)
+{
+    if(top.node == json_schema::any)
+    {
+        next = json_schema::any;
+    }
+    else if(key.empty())
+    {
+        if(! on_name(s, ec))
+            return false;
+    }
+    else
+    {
+        key.append(s);
+        bool const ok = on_name(key, ec);
+        key.clear();
+        if(! ok)
+            return false;
+    }
+    return h.on_key(s, n, ec);
+}
+
+bool
+schema_handler::
+on_string_part(
+    string_view s,
+    std::size_t n,
+    error_code& ec)
+{
+    if(! partial)
+    {
+        cur = begin_value();
+        if(! check_type(cur,
+                json_schema::string_type, ec))
+            return false;
+        partial = true;
+        len = 0;
+    }
+    if(cur != json_schema::any)
+    {
+        len += json_schema::code_points(s);
+        if(! check_length(ec))
+            return false;
+    }
+    return h.on_string_part(s, n, ec);
+}
+
+bool
+schema_handler::
+on_string(
+    string_view s,
+    std::size_t n,
+    error_code& ec)
+{
+    if(! partial)
+    {
+        cur = begin_value();
+        if(! check_type(cur,
+                json_schema::string_type, ec))
+            return false;
+        len = 0;
+    }
+    partial = false;
+    if(cur != json_schema::any)
+    {
+        len += json_schema::code_points(s);
+        if(! check_length(ec))
+            return false;
+        if(len < schema.at(cur).min_length)
+        {
+            ec = error::size_out_of_range;
+            return false;
+        }
+    }
+    return h.on_string(s, n, ec);
+}
+
+bool
+schema_handler::
+on_number_part(
+    string_view s,
+    error_code& ec)
+{
+    return h.on_number_part(s, ec);
+}
+
+bool
+schema_handler::
+on_int64(
+    std::int64_t i,
+    string_view s,
+    error_code& ec)
+{
+    json_schema::bound b;
+    b.k = kind::int64;
+    b.i = i;
+    return
+        check_number(b, ec) &&
+        h.on_int64(i, s, ec);
+}
+
+bool
+schema_handler::
+on_uint64(
+    std::uint64_t u,
+    string_view s,
+    error_code& ec)
+{
+    json_schema::bound b;
+    b.k = kind::uint64;
+    b.u = u;
+    return
+        check_number(b, ec) &&
+        h.on_uint64(u, s, ec);
+}
+
+bool
+schema_handler::
+on_double(
+    double d,
+    string_view s,
+    error_code& ec)
+{
+    json_schema::bound b;
+    b.k = kind::double_;
+    b.d = d;
+    return
+        check_number(b, ec) &&
+        h.on_double(d, s, ec);
+}
+
+bool
+schema_handler::
+on_bool(
+    bool b,
+    error_code& ec)
+{
+    return
+        check_type(begin_value(),
+            json_schema::boolean_type, ec) &&
+        h.on_bool(b, ec);
+}
+
+bool
+schema_handler::
+on_null(error_code& ec)
+{
+    return
+        check_type(begin_value(),
+            json_schema::null_type, ec) &&
+        h.on_null(ec);
+}
+
+bool
+schema_handler::
+on_comment_part(
+    string_view s,
+    error_code& ec)
+{
+    return h.on_comment_part(s, ec);
+}
+
+bool
+schema_handler::
+on_comment(
+    string_view s,
+    error_code& ec)
+{
+    return h.on_comment(s, ec);
+}
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
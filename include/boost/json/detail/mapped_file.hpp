@@ -0,0 +1,54 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_MAPPED_FILE_HPP
+#define BOOST_JSON_DETAIL_MAPPED_FILE_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/error.hpp>
+#include <boost/json/string_view.hpp>
+#include <cstddef>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+// A read-only view of the contents of a file.
+// On POSIX systems the file is mapped into memory,
+// elsewhere it is read into a heap buffer.
+class mapped_file
+{
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+    bool mapped_ = false;
+
+public:
+    mapped_file() = default;
+    mapped_file(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file const&) = delete;
+
+    BOOST_JSON_DECL
+    ~mapped_file();
+
+    BOOST_JSON_DECL
+    void
+    open(
+        char const* path,
+        error_code& ec);
+
+    string_view
+    view() const noexcept
+    {
+        return { data_, size_ };
+    }
+};
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
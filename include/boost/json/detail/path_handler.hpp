@@ -0,0 +1,103 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_PATH_HANDLER_HPP
+#define BOOST_JSON_DETAIL_PATH_HANDLER_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/json_path.hpp>
+#include <boost/json/object.hpp>
+#include <boost/json/string.hpp>
+#include <boost/json/string_view.hpp>
+#include <boost/json/value_stack.hpp>
+#include <boost/json/detail/stack.hpp>
+#include <cstdint>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+// Runs the automaton of a json_path over parser
+// events, building only the values which match.
+struct path_handler
+{
+    static constexpr std::size_t
+        max_object_size = object::max_size();
+
+    static constexpr std::size_t
+        max_array_size = array::max_size();
+
+    static constexpr std::size_t
+        max_key_size = string::max_size();
+
+    static constexpr std::size_t
+        max_string_size = string::max_size();
+
+    using mask_type = json_path::mask_type;
+
+    struct frame
+    {
+        mask_type mask;
+        std::size_t index;
+        bool is_array;
+    };
+
+    json_path path;
+    array matches;
+    value_stack st;
+    string key;             // key parts, outside of a match
+    stack frames;           // enclosing containers
+    std::size_t depth = 0;  // number of containers in `frames`
+    std::size_t cap = 0;    // capacity of `frames`
+    frame top{};            // innermost container
+    mask_type next = 0;     // mask for the value after a key
+    mask_type match = 0;    // mask of the match being built
+    std::size_t nest = 0;   // open containers in the match
+    bool building = false;
+    bool partial = false;   // inside a split string or number
+    bool record = false;    // the split value is being built
+
+    BOOST_JSON_DECL
+    path_handler(
+        json_path const& jp,
+        storage_ptr sp);
+
+    inline void reset() noexcept;
+    inline mask_type begin_value() noexcept;
+    inline bool begin_scalar();
+    inline void end_scalar();
+    inline bool begin_container(bool is_array);
+    inline void end_container();
+    inline void push_frame(mask_type m, bool is_array);
+    BOOST_JSON_DECL void finish_match();
+
+    inline bool on_document_begin(error_code& ec);
+    inline bool on_document_end(error_code& ec);
+    inline bool on_object_begin(error_code& ec);
+    inline bool on_object_end(std::size_t n, error_code& ec);
+    inline bool on_array_begin(error_code& ec);
+    inline bool on_array_end(std::size_t n, error_code& ec);
+    inline bool on_key_part(string_view s, std::size_t n, error_code& ec);
+    inline bool on_key(string_view s, std::size_t n, error_code& ec);
+    inline bool on_string_part(string_view s, std::size_t n, error_code& ec);
+    inline bool on_string(string_view s, std::size_t n, error_code& ec);
+    inline bool on_number_part(string_view, error_code&);
+    inline bool on_int64(std::int64_t i, string_view, error_code& ec);
+    inline bool on_uint64(std::uint64_t u, string_view, error_code& ec);
+    inline bool on_double(double d, string_view, error_code& ec);
+    inline bool on_bool(bool b, error_code& ec);
+    inline bool on_null(error_code& ec);
+    inline bool on_comment_part(string_view, error_code&);
+    inline bool on_comment(string_view, error_code&);
+};
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
@@ -665,8 +665,55 @@ static inline bool d2d_small_int(const uint64_t ieeeMantissa, const uint32_t iee
   return true;
 }
 
+inline
+floating_decimal_64
+d2d_shortest(
+    const std::uint64_t ieeeMantissa,
+    const std::uint32_t ieeeExponent)
+{
+    floating_decimal_64 v;
+    const bool isSmallInt = d2d_small_int(ieeeMantissa, ieeeExponent, &v);
+    if (isSmallInt) {
+        // For small integers in the range [1, 2^53), v.mantissa might contain trailing (decimal) zeros.
+        // For scientific notation we need to move these zeros into the exponent.
+        // (This is not needed for fixed-point notation, so it might be beneficial to trim
+        // trailing zeros in to_chars only if needed - once fixed-point notation output is implemented.)
+        for (;;) {
+            std::uint64_t const q = div10(v.mantissa);
+            std::uint32_t const r = ((std::uint32_t) v.mantissa) - 10 * ((std::uint32_t) q);
+            if (r != 0)
+                break;
+            v.mantissa = q;
+            ++v.exponent;
+        }
+    }
+    else {
+        v = d2d(ieeeMantissa, ieeeExponent);
+    }
+    return v;
+}
+
 } // detail
 
+bool
+d2d_shortest(
+    double f,
+    std::uint64_t& mantissa,
+    std::int32_t& exponent) noexcept
+{
+    using namespace detail;
+    std::uint64_t const bits = double_to_bits(f);
+    const std::uint64_t ieeeMantissa = bits & ((1ull << DOUBLE_MANTISSA_BITS) - 1);
+    const std::uint32_t ieeeExponent = (std::uint32_t)((bits >> DOUBLE_MANTISSA_BITS) & ((1u << DOUBLE_EXPONENT_BITS) - 1));
+    if (ieeeExponent == ((1u << DOUBLE_EXPONENT_BITS) - 1u) || (ieeeExponent == 0 && ieeeMantissa == 0)) {
+        return false;
+    }
+    floating_decimal_64 const v = d2d_shortest(ieeeMantissa, ieeeExponent);
+    mantissa = v.mantissa;
+    exponent = v.exponent;
+    return true;
+}
+
 int
 d2s_buffered_n(
     double f,
@@ -693,27 +740,7 @@ d2s_buffered_n(
         return copy_special_str(result, ieeeSign, ieeeExponent != 0, ieeeMantissa != 0);
     }
 
-    floating_decimal_64 v;
-    const bool isSmallInt = d2d_small_int(ieeeMantissa, ieeeExponent, &v);
-    if (isSmallInt) {
-        // For small integers in the range [1, 2^53), v.mantissa might contain trailing (decimal) zeros.
-        // For scientific notation we need to move these zeros into the exponent.
-        // (This is not needed for fixed-point notation, so it might be beneficial to trim
-        // trailing zeros in to_chars only if needed - once fixed-point notation output is implemented.)
-        for (;;) {
-            std::uint64_t const q = div10(v.mantissa);
-            std::uint32_t const r = ((std::uint32_t) v.mantissa) - 10 * ((std::uint32_t) q);
-            if (r != 0)
-                break;
-            v.mantissa = q;
-            ++v.exponent;
-        }
-    }
-    else {
-        v = d2d(ieeeMantissa, ieeeExponent);
-    }
-
-    return to_chars(v, ieeeSign, result);
+    return to_chars(d2d_shortest(ieeeMantissa, ieeeExponent), ieeeSign, result);
 }
 
 void
@@ -38,6 +38,12 @@ void d2s_buffered(double f, char* result) noexcept;
 BOOST_JSON_DECL
 char* d2s(double f) noexcept;
 
+// Set |f| == mantissa * 10^exponent using the fewest
+// digits which round trip, or return false if f is
+// zero, infinite or NaN.
+BOOST_JSON_DECL
+bool d2d_shortest(double f, std::uint64_t& mantissa, std::int32_t& exponent) noexcept;
+
 } // ryu
 
 } // detail
@@ -0,0 +1,99 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_SCHEMA_HANDLER_HPP
+#define BOOST_JSON_DETAIL_SCHEMA_HANDLER_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/json_schema.hpp>
+#include <boost/json/string.hpp>
+#include <boost/json/string_view.hpp>
+#include <boost/json/detail/handler.hpp>
+#include <boost/json/detail/stack.hpp>
+#include <cstdint>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+// Checks parser events against a json_schema
+// before forwarding them to the value building
+// handler, failing on the first violation.
+struct schema_handler
+{
+    static constexpr std::size_t
+        max_object_size = handler::max_object_size;
+
+    static constexpr std::size_t
+        max_array_size = handler::max_array_size;
+
+    static constexpr std::size_t
+        max_key_size = handler::max_key_size;
+
+    static constexpr std::size_t
+        max_string_size = handler::max_string_size;
+
+    using node = json_schema::node;
+
+    struct frame
+    {
+        std::size_t node;
+        std::uint64_t seen;     // required properties
+        bool is_array;
+    };
+
+    handler h;
+    json_schema schema;
+    string key;             // key parts
+    stack frames;           // enclosing containers
+    std::size_t depth = 0;  // number of containers in `frames`
+    std::size_t cap = 0;    // capacity of `frames`
+    frame top{};            // innermost container
+    std::size_t next = 0;   // schema for the value after a key
+    std::size_t cur = 0;    // schema of a split string
+    std::size_t len = 0;    // code points of a split string
+    bool partial = false;   // inside a split string
+
+    BOOST_JSON_DECL
+    schema_handler(
+        json_schema const& js,
+        storage_ptr sp);
+
+    inline void reset() noexcept;
+    inline std::size_t begin_value() const noexcept;
+    inline bool check_type(std::size_t i, unsigned t, error_code& ec) const noexcept;
+    inline bool check_number(json_schema::bound const& b, error_code& ec) const noexcept;
+    inline bool check_length(error_code& ec) const noexcept;
+    inline bool begin_container(bool is_array, error_code& ec);
+    inline bool end_container(std::size_t n, error_code& ec);
+    inline bool on_name(string_view s, error_code& ec) noexcept;
+
+    inline bool on_document_begin(error_code& ec);
+    inline bool on_document_end(error_code& ec);
+    inline bool on_object_begin(error_code& ec);
+    inline bool on_object_end(std::size_t n, error_code& ec);
+    inline bool on_array_begin(error_code& ec);
+    inline bool on_array_end(std::size_t n, error_code& ec);
+    inline bool on_key_part(string_view s, std::size_t n, error_code& ec);
+    inline bool on_key(string_view s, std::size_t n, error_code& ec);
+    inline bool on_string_part(string_view s, std::size_t n, error_code& ec);
+    inline bool on_string(string_view s, std::size_t n, error_code& ec);
+    inline bool on_number_part(string_view, error_code&);
+    inline bool on_int64(std::int64_t i, string_view, error_code& ec);
+    inline bool on_uint64(std::uint64_t u, string_view, error_code& ec);
+    inline bool on_double(double d, string_view, error_code& ec);
+    inline bool on_bool(bool b, error_code& ec);
+    inline bool on_null(error_code& ec);
+    inline bool on_comment_part(string_view, error_code&);
+    inline bool on_comment(string_view, error_code&);
+};
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
@@ -19,6 +19,9 @@
 #ifdef BOOST_JSON_USE_SSE2
 # include <emmintrin.h>
 # include <xmmintrin.h>
+# ifdef BOOST_JSON_USE_SSSE3
+#  include <tmmintrin.h>
+# endif
 # ifdef _MSC_VER
 #  include <intrin.h>
 # endif
@@ -79,6 +82,141 @@ count_valid(
     return p;
 }
 
+#ifdef BOOST_JSON_USE_SSSE3
+
+// Returns a non-zero lane for every byte of `v` which
+// is part of an invalid utf-8 sequence, given the
+// previous 16 bytes of input in `prev`.
+//
+// Reference:
+//   John Keiser, Daniel Lemire,
+//   "Validating UTF-8 In Less Than One Instruction Per Byte"
+//   https://arxiv.org/abs/2010.03090
+inline
+__m128i
+utf8_errors(
+    __m128i v,
+    __m128i prev) noexcept
+{
+    // bits of the lookup tables, each is an error
+    // condition on the first two bytes of a sequence
+    constexpr char too_short  = 1 << 0; // 11______ 0_______
+                                        // 11______ 11______
+    constexpr char too_long   = 1 << 1; // 0_______ 10______
+    constexpr char overlong_3 = 1 << 2; // 11100000 100_____
+    constexpr char too_large  = 1 << 3; // 11110100 1001____
+                                        // 11110100 101_____
+                                        // 11110101 1001____
+                                        // 11110101 101_____
+                                        // 1111011_ 1001____
+                                        // 1111011_ 101_____
+                                        // 11111___ 1001____
+                                        // 11111___ 101_____
+    constexpr char surrogate  = 1 << 4; // 11101101 101_____
+    constexpr char overlong_2 = 1 << 5; // 1100000_ 10______
+    constexpr char too_large_1000 = 1 << 6;
+                                        // 11110101 1000____
+                                        // 1111011_ 1000____
+                                        // 11111___ 1000____
+    constexpr char overlong_4 = 1 << 6; // 11110000 1000____
+    constexpr char two_conts  = char(1 << 7); // 10______ 10______
+    constexpr char carry = too_short | too_long | two_conts;
+
+    __m128i const nibble = _mm_set1_epi8( 0x0F );
+
+    __m128i const prev1 = _mm_alignr_epi8( v, prev, 15 );
+    __m128i const byte_1_high = _mm_shuffle_epi8(
+        _mm_setr_epi8(
+            // 0_______ ________ <ASCII in byte 1>
+            too_long, too_long, too_long, too_long,
+            too_long, too_long, too_long, too_long,
+            // 10______ ________ <continuation in byte 1>
+            two_conts, two_conts, two_conts, two_conts,
+            // 1100____ ________ <two byte lead in byte 1>
+            too_short | overlong_2,
+            // 1101____ ________ <two byte lead in byte 1>
+            too_short,
+            // 1110____ ________ <three byte lead in byte 1>
+            too_short | overlong_3 | surrogate,
+            // 1111____ ________ <four+ byte lead in byte 1>
+            too_short | too_large | too_large_1000 | overlong_4),
+        _mm_and_si128( _mm_srli_epi16( prev1, 4 ), nibble ));
+    __m128i const byte_1_low = _mm_shuffle_epi8(
+        _mm_setr_epi8(
+            // ____0000 ________
+            carry | overlong_3 | overlong_2 | overlong_4,
+            // ____0001 ________
+            carry | overlong_2,
+            // ____001_ ________
+            carry,
+            carry,
+            // ____0100 ________
+            carry | too_large,
+            // ____0101 ________
+            carry | too_large | too_large_1000,
+            // ____011_ ________
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            // ____1___ ________
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000,
+            // ____1101 ________
+            carry | too_large | too_large_1000 | surrogate,
+            carry | too_large | too_large_1000,
+            carry | too_large | too_large_1000),
+        _mm_and_si128( prev1, nibble ));
+    __m128i const byte_2_high = _mm_shuffle_epi8(
+        _mm_setr_epi8(
+            // ________ 0_______ <ASCII in byte 2>
+            too_short, too_short, too_short, too_short,
+            too_short, too_short, too_short, too_short,
+            // ________ 1000____
+            too_long | overlong_2 | two_conts |
+                overlong_3 | too_large_1000 | overlong_4,
+            // ________ 1001____
+            too_long | overlong_2 | two_conts |
+                overlong_3 | too_large,
+            // ________ 101_____
+            too_long | overlong_2 | two_conts |
+                surrogate | too_large,
+            too_long | overlong_2 | two_conts |
+                surrogate | too_large,
+            // ________ 11______
+            too_short, too_short, too_short, too_short),
+        _mm_and_si128( _mm_srli_epi16( v, 4 ), nibble ));
+    __m128i const special = _mm_and_si128(
+        _mm_and_si128( byte_1_high, byte_1_low ), byte_2_high );
+
+    // the third and fourth bytes of a sequence must be
+    // continuations, which cancels out two_conts above
+    __m128i const prev2 = _mm_alignr_epi8( v, prev, 14 );
+    __m128i const prev3 = _mm_alignr_epi8( v, prev, 13 );
+    __m128i const must_be_cont = _mm_or_si128(
+        _mm_subs_epu8( prev2, _mm_set1_epi8( char(0xE0 - 0x80) ) ),
+        _mm_subs_epu8( prev3, _mm_set1_epi8( char(0xF0 - 0x80) ) ));
+    return _mm_xor_si128(
+        _mm_and_si128( must_be_cont, _mm_set1_epi8( char(0x80) ) ),
+        special );
+}
+
+// Returns a non-zero lane if the last bytes
+// of `v` begin a sequence which is not complete
+inline
+__m128i
+utf8_incomplete(__m128i v) noexcept
+{
+    return _mm_subs_epu8( v, _mm_setr_epi8(
+        char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+        char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+        char(0xFF), char(0xFF), char(0xFF), char(0xFF),
+        char(0xFF), char(0xF0 - 1), char(0xE0 - 1), char(0xC0 - 1) ));
+}
+
+#endif
+
 template<>
 inline
 const char*
@@ -90,6 +228,64 @@ count_valid<false>(
     __m128i const q2 = _mm_set1_epi8( '\\' );
     __m128i const q3 = _mm_set1_epi8( 0x20 );
 
+#ifdef BOOST_JSON_USE_SSSE3
+    __m128i const q4 = _mm_set1_epi8( 0x1F );
+    __m128i const zero = _mm_setzero_si128();
+    __m128i prev = zero;
+    __m128i incomplete = zero;
+    bool partial = false;
+
+    while(end - p >= 16)
+    {
+        __m128i v1 = _mm_loadu_si128( (__m128i const*)p );
+
+        __m128i v2 = _mm_cmpeq_epi8( v1, q1 );
+        __m128i v3 = _mm_cmpeq_epi8( v1, q2 );
+        __m128i v4 = _mm_cmplt_epi8( v1, q3 );
+
+        __m128i v5 = _mm_or_si128( v2, v3 );
+        __m128i v6 = _mm_or_si128( v5, v4 );
+
+        if( _mm_movemask_epi8( v6 ) != 0 )
+        {
+            // the block is not plain ascii, stop if it has a
+            // special character, the exact position of which
+            // is found by the loop below
+            __m128i v7 = _mm_cmpeq_epi8( _mm_min_epu8( v1, q4 ), v1 );
+            if( _mm_movemask_epi8( _mm_or_si128( v5, v7 ) ) != 0 )
+                break;
+            if( _mm_movemask_epi8( _mm_cmpeq_epi8(
+                utf8_errors( v1, prev ), zero ) ) != 0xFFFF )
+                break;
+            incomplete = utf8_incomplete( v1 );
+            partial = _mm_movemask_epi8(
+                _mm_cmpeq_epi8( incomplete, zero ) ) != 0xFFFF;
+        }
+        else if( partial )
+        {
+            // a sequence in the previous
+            // block was not finished
+            break;
+        }
+
+        prev = v1;
+        p += 16;
+    }
+
+    // back up to the start of a sequence
+    // which spans the previous block
+    if( partial )
+    {
+        for(int i = 1; i <= 3; ++i)
+        {
+            if( static_cast<unsigned char>( p[-i] ) >= 0xC0 )
+            {
+                p -= i;
+                break;
+            }
+        }
+    }
+#else
     while(end - p >= 16)
     {
         __m128i v1 = _mm_loadu_si128( (__m128i const*)p );
@@ -103,22 +299,52 @@ count_valid<false>(
 
         int w = _mm_movemask_epi8( v6 );
 
-        if( w != 0 )
+        if( w == 0 )
         {
-            int m;
+            p += 16;
+            continue;
+        }
+
+        int m;
 #if defined(__GNUC__) || defined(__clang__)
-            m = __builtin_ffs( w ) - 1;
+        m = __builtin_ffs( w ) - 1;
 #else
-            unsigned long index;
-            _BitScanForward( &index, w );
-            m = index;
+        unsigned long index;
+        _BitScanForward( &index, w );
+        m = index;
 #endif
+        if( static_cast<unsigned char>( p[m] ) < 0x80 )
+        {
             p += m;
             break;
         }
 
-        p += 16;
+        // validate utf-8 up to the end of the block and
+        // through any multibyte run which follows it, then
+        // resume the vectorized scan
+        char const* const last = p + 16;
+        p += m;
+        while(p < last || (p != end &&
+            static_cast<unsigned char>( *p ) >= 0x80))
+        {
+            const unsigned char c = *p;
+            if(c == '\x22' || c == '\\' || c < 0x20)
+                return p;
+            if(c < 0x80)
+            {
+                ++p;
+                continue;
+            }
+            uint16_t first = classify_utf8(c & 0x7F);
+            uint8_t len = first & 0xFF;
+            if(BOOST_JSON_UNLIKELY(end - p < len))
+                return p;
+            if(BOOST_JSON_UNLIKELY(! is_valid_utf8(p, first)))
+                return p;
+            p += len;
+        }
     }
+#endif
 
     while(p != end)
     {
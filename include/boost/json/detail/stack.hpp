@@ -12,6 +12,7 @@
 
 #include <boost/json/detail/config.hpp>
 #include <boost/json/storage_ptr.hpp>
+#include <algorithm>
 #include <cstring>
 
 BOOST_JSON_NS_BEGIN
@@ -40,6 +41,33 @@ public:
         size_ = 0;
     }
 
+    std::size_t
+    size() const noexcept
+    {
+        return size_;
+    }
+
+    std::size_t
+    capacity() const noexcept
+    {
+        return cap_;
+    }
+
+    char*
+    data() noexcept
+    {
+        return buf_;
+    }
+
+    // discard everything above
+    // the first n bytes
+    void
+    shrink(std::size_t n) noexcept
+    {
+        BOOST_ASSERT(n <= size_);
+        size_ = n;
+    }
+
     BOOST_JSON_DECL
     void
     reserve(std::size_t n);
@@ -54,7 +82,12 @@ public:
         // reserve enough to prevent a
         // reallocation.
         //BOOST_ASSERT(cap_ >= size_ + n);
-        reserve(size_ + n);
+        if(cap_ < size_ + n)
+            // grow geometrically, so that a long
+            // run of pushes copies the stack only
+            // a logarithmic number of times
+            reserve((std::max)(
+                2 * cap_, size_ + n));
         std::memcpy(
             buf_ + size_, &t, n);
         size_ += n;
@@ -0,0 +1,74 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_DETAIL_TRACE_HPP
+#define BOOST_JSON_DETAIL_TRACE_HPP
+
+#include <boost/json/trace.hpp>
+
+// Declares a span named `name` which reports
+// the operation to the trace hooks, or expands
+// to nothing when tracing is not enabled.
+#ifdef BOOST_JSON_TRACE
+# define BOOST_JSON_TRACE_SPAN(name, ev, n) \
+    ::boost::json::detail::trace_span name( \
+        ::boost::json::trace_event::ev, n)
+# define BOOST_JSON_TRACE_RESULT(name, n) \
+    name.result(n)
+#else
+# define BOOST_JSON_TRACE_SPAN(name, ev, n)
+# define BOOST_JSON_TRACE_RESULT(name, n)
+#endif
+
+#ifdef BOOST_JSON_TRACE
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+class trace_span
+{
+    trace_hooks* h_;
+    trace_event ev_;
+    std::size_t n_ = 0;
+
+public:
+    trace_span(
+        trace_event ev,
+        std::size_t n) noexcept
+        : h_(get_trace_hooks())
+        , ev_(ev)
+    {
+        if(h_)
+            h_->on_begin(ev_, n);
+    }
+
+    trace_span(trace_span const&) = delete;
+    trace_span& operator=(trace_span const&) = delete;
+
+    ~trace_span()
+    {
+        // the hooks seen at the beginning also
+        // see the end, even if they were replaced
+        if(h_)
+            h_->on_end(ev_, n_);
+    }
+
+    void
+    result(std::size_t n) noexcept
+    {
+        n_ = n;
+    }
+};
+
+} // detail
+BOOST_JSON_NS_END
+
+#endif
+
+#endif
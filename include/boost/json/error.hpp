@@ -211,6 +211,43 @@ enum class error
     /// number cast is not exact
     not_exact,
 
+    //----------------------------------
+
+    /// JSON Pointer does not begin with '/'
+    missing_slash,
+
+    /// JSON Pointer contains an invalid escape sequence
+    invalid_escape,
+
+    /// JSON Pointer reference token is not an array index
+    token_not_number,
+
+    /// JSON Pointer refers to a value which does not exist
+    not_found,
+
+    /// JSON Pointer reference token applied to a scalar value
+    value_is_scalar,
+
+    //----------------------------------
+
+    /// JSON Schema is malformed or uses an unsupported keyword
+    invalid_schema,
+
+    /// A value has a type which the schema does not allow
+    type_mismatch,
+
+    /// An object lacks a property required by the schema
+    required_missing,
+
+    /// An object has a property which the schema does not allow
+    additional_property,
+
+    /// A number lies outside the range allowed by the schema
+    out_of_range,
+
+    /// A string, array or object has a size the schema does not allow
+    size_out_of_range,
+
     /// test failure
     test_failure,
 };
@@ -223,7 +260,13 @@ enum class condition
     parse_error = 1,
 
     /// An error on assignment to or from a JSON value
-    assign_error
+    assign_error,
+
+    /// An error related to parsing or using a JSON Pointer
+    pointer_error,
+
+    /// A value does not conform to a JSON Schema
+    schema_error
 };
 
 BOOST_JSON_NS_END
@@ -47,6 +47,17 @@ case error::string_too_large: return "string too large";
 case error::exception: return "got exception";
 case error::not_number: return "not a number";
 case error::not_exact: return "not exact";
+case error::missing_slash: return "JSON Pointer missing leading '/'";
+case error::invalid_escape: return "invalid JSON Pointer escape";
+case error::token_not_number: return "JSON Pointer token is not an array index";
+case error::not_found: return "JSON Pointer refers to a missing value";
+case error::value_is_scalar: return "JSON Pointer token applied to a scalar";
+case error::invalid_schema: return "invalid JSON Schema";
+case error::type_mismatch: return "value type not allowed by JSON Schema";
+case error::required_missing: return "required property missing";
+case error::additional_property: return "property not allowed by JSON Schema";
+case error::out_of_range: return "number out of range";
+case error::size_out_of_range: return "size out of range";
 
 case error::test_failure: return "test failure";
             }
@@ -80,6 +91,21 @@ case error::exception:
 case error::not_number:
 case error::not_exact:
     return condition::assign_error;
+
+case error::missing_slash:
+case error::invalid_escape:
+case error::token_not_number:
+case error::not_found:
+case error::value_is_scalar:
+    return condition::pointer_error;
+
+case error::invalid_schema:
+case error::type_mismatch:
+case error::required_missing:
+case error::additional_property:
+case error::out_of_range:
+case error::size_out_of_range:
+    return condition::schema_error;
             }
         }
     };
@@ -110,6 +136,10 @@ make_error_condition(condition c)
                 return "A JSON parse error occurred";
             case condition::assign_error:
                 return "An error occurred during assignment";
+            case condition::pointer_error:
+                return "A JSON Pointer error occurred";
+            case condition::schema_error:
+                return "A JSON Schema error occurred";
             }
         }
     };
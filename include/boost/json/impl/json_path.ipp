@@ -0,0 +1,495 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_JSON_PATH_IPP
+#define BOOST_JSON_IMPL_JSON_PATH_IPP
+
+#include <boost/json/json_path.hpp>
+#include <boost/json/detail/except.hpp>
+#include <cstring>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+
+struct json_path::segment
+{
+    enum class kind : unsigned char
+    {
+        name,
+        wildcard,
+        slice
+    };
+
+    std::size_t offset; // name, from start of allocation
+    std::size_t size;
+    std::size_t start;  // slice
+    std::size_t end;
+    std::size_t step;
+    kind k;
+    bool descendant;
+
+    bool
+    matches(string_view key,
+        char const* text) const noexcept
+    {
+        if(k == kind::wildcard)
+            return true;
+        return k == kind::name &&
+            key == string_view(text + offset, size);
+    }
+
+    bool
+    matches(std::size_t i) const noexcept
+    {
+        if(k == kind::wildcard)
+            return true;
+        return k == kind::slice &&
+            i >= start && i < end &&
+            (i - start) % step == 0;
+    }
+};
+
+namespace detail {
+
+class path_scanner
+{
+    char const* p_;
+    char const* const end_;
+
+public:
+    path_scanner(string_view s) noexcept
+        : p_(s.data())
+        , end_(s.data() + s.size())
+    {
+    }
+
+    bool
+    done() const noexcept
+    {
+        return p_ == end_;
+    }
+
+    bool
+    skip(char c) noexcept
+    {
+        if(p_ == end_ || *p_ != c)
+            return false;
+        ++p_;
+        return true;
+    }
+
+    // returns false and leaves `result`
+    // unchanged if there are no digits
+    bool
+    number(std::size_t& result) noexcept
+    {
+        char const* const first = p_;
+        std::size_t v = 0;
+        while(p_ != end_ && static_cast<
+            unsigned char>(*p_ - '0') < 10)
+        {
+            std::size_t const d = *p_ - '0';
+            // saturate, no array is that large
+            if(v > (std::size_t(-1) - d) / 10)
+                v = std::size_t(-1);
+            else
+                v = 10 * v + d;
+            ++p_;
+        }
+        if(p_ == first)
+            return false;
+        result = v;
+        return true;
+    }
+
+    // unquoted member name
+    bool
+    name(char*& out) noexcept
+    {
+        char const* const first = p_;
+        while(p_ != end_ &&
+            *p_ != '.' && *p_ != '[' &&
+            static_cast<unsigned char>(*p_) > ' ')
+            *out++ = *p_++;
+        return p_ != first;
+    }
+
+    // quoted member name, after the quote
+    bool
+    quoted(char q, char*& out) noexcept
+    {
+        for(;;)
+        {
+            if(p_ == end_)
+                return false;
+            char c = *p_++;
+            if(c == q)
+                return true;
+            if(c == '\\')
+            {
+                if(p_ == end_)
+                    return false;
+                c = *p_++;
+                if(c != q && c != '\\')
+                    return false;
+            }
+            *out++ = c;
+        }
+    }
+
+    char
+    peek() const noexcept
+    {
+        return p_ == end_ ? 0 : *p_;
+    }
+};
+
+} // detail
+
+//----------------------------------------------------------
+
+json_path::
+~json_path()
+{
+    release();
+}
+
+json_path::
+json_path(
+    string_view s,
+    storage_ptr sp)
+    : sp_(std::move(sp))
+{
+    error_code ec;
+    parse(s, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+}
+
+json_path::
+json_path(
+    string_view s,
+    error_code& ec,
+    storage_ptr sp)
+    : sp_(std::move(sp))
+{
+    parse(s, ec);
+}
+
+json_path::
+json_path(json_path const& other)
+    : sp_(other.sp_)
+{
+    if(! other.s_)
+        return;
+    s_ = static_cast<segment*>(
+        sp_->allocate(other.bytes_,
+            alignof(segment)));
+    std::memcpy(s_, other.s_, other.bytes_);
+    n_ = other.n_;
+    bytes_ = other.bytes_;
+}
+
+json_path::
+json_path(json_path&& other) noexcept
+    : sp_(other.sp_)
+    , s_(other.s_)
+    , n_(other.n_)
+    , bytes_(other.bytes_)
+{
+    other.s_ = nullptr;
+    other.n_ = 0;
+    other.bytes_ = 0;
+}
+
+json_path&
+json_path::
+operator=(json_path const& other)
+{
+    if(this == &other)
+        return *this;
+    segment* s = nullptr;
+    if(other.s_)
+    {
+        // copy into our resource
+        s = static_cast<segment*>(
+            sp_->allocate(other.bytes_,
+                alignof(segment)));
+        std::memcpy(s, other.s_, other.bytes_);
+    }
+    release();
+    s_ = s;
+    n_ = other.n_;
+    bytes_ = other.bytes_;
+    return *this;
+}
+
+json_path&
+json_path::
+operator=(json_path&& other)
+{
+    if(*sp_ != *other.sp_)
+        return *this = static_cast<
+            json_path const&>(other);
+    release();
+    s_ = other.s_;
+    n_ = other.n_;
+    bytes_ = other.bytes_;
+    other.s_ = nullptr;
+    other.n_ = 0;
+    other.bytes_ = 0;
+    return *this;
+}
+
+array
+json_path::
+select(
+    value const& jv,
+    storage_ptr sp) const
+{
+    array out(std::move(sp));
+    select_impl(jv, start(), out);
+    return out;
+}
+
+//----------------------------------------------------------
+
+auto
+json_path::
+step(
+    mask_type m,
+    string_view key) const noexcept ->
+        mask_type
+{
+    mask_type r = 0;
+    // the accepting bit has no successors
+    m &= ~accept();
+    for(std::size_t i = 0; m; ++i, m >>= 1)
+    {
+        if(! (m & 1))
+            continue;
+        auto const& seg = s_[i];
+        if(seg.descendant)
+            r |= mask_type(1) << i;
+        if(seg.matches(key, text()))
+            r |= mask_type(2) << i;
+    }
+    return r;
+}
+
+auto
+json_path::
+step(
+    mask_type m,
+    std::size_t index) const noexcept ->
+        mask_type
+{
+    mask_type r = 0;
+    m &= ~accept();
+    for(std::size_t i = 0; m; ++i, m >>= 1)
+    {
+        if(! (m & 1))
+            continue;
+        auto const& seg = s_[i];
+        if(seg.descendant)
+            r |= mask_type(1) << i;
+        if(seg.matches(index))
+            r |= mask_type(2) << i;
+    }
+    return r;
+}
+
+void
+json_path::
+select_impl(
+    value const& jv,
+    mask_type m,
+    array& out) const
+{
+    if(m & accept())
+        out.emplace_back(jv);
+    if(! (m & ~accept()))
+        return;
+    switch(jv.kind())
+    {
+    case kind::object:
+        for(auto const& kv : jv.get_object())
+        {
+            auto const m1 = step(m, kv.key());
+            if(m1)
+                select_impl(kv.value(), m1, out);
+        }
+        break;
+
+    case kind::array:
+    {
+        auto const& arr = jv.get_array();
+        for(std::size_t i = 0; i < arr.size(); ++i)
+        {
+            auto const m1 = step(m, i);
+            if(m1)
+                select_impl(arr[i], m1, out);
+        }
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+//----------------------------------------------------------
+
+void
+json_path::
+parse(
+    string_view s,
+    error_code& ec)
+{
+    detail::path_scanner sc(s);
+    if(! sc.skip('$'))
+    {
+        ec = error::syntax;
+        return;
+    }
+
+    // Names are never longer than the expression,
+    // and each segment uses at least two characters.
+    std::size_t const n = s.size() / 2;
+    std::size_t const bytes =
+        n * sizeof(segment) + s.size();
+    auto const segs = static_cast<segment*>(
+        sp_->allocate(bytes, alignof(segment)));
+    char* const base = reinterpret_cast<
+        char*>(segs);
+    char* out = base + n * sizeof(segment);
+    std::size_t count = 0;
+
+    auto const fail = [&](error e)
+    {
+        sp_->deallocate(segs, bytes,
+            alignof(segment));
+        ec = e;
+    };
+
+    while(! sc.done())
+    {
+        if(count == max_size)
+            return fail(error::too_deep);
+        BOOST_ASSERT(count < n);
+        segment& seg = segs[count];
+        seg.offset = out - base;
+        seg.size = 0;
+        seg.start = 0;
+        seg.end = std::size_t(-1);
+        seg.step = 1;
+        seg.k = segment::kind::name;
+        seg.descendant = false;
+        bool bracket;
+        if(sc.skip('.'))
+        {
+            seg.descendant = sc.skip('.');
+            bracket = sc.peek() == '[';
+            if(! bracket)
+            {
+                if(sc.skip('*'))
+                    seg.k = segment::kind::wildcard;
+                else if(! sc.name(out))
+                    return fail(error::syntax);
+            }
+            else if(! seg.descendant)
+            {
+                // ".[" is not valid
+                return fail(error::syntax);
+            }
+        }
+        else
+        {
+            bracket = sc.peek() == '[';
+            if(! bracket)
+                return fail(error::syntax);
+        }
+        if(bracket)
+        {
+            sc.skip('[');
+            if(sc.skip('*'))
+            {
+                seg.k = segment::kind::wildcard;
+            }
+            else if(sc.skip('\''))
+            {
+                if(! sc.quoted('\'', out))
+                    return fail(error::syntax);
+            }
+            else if(sc.skip('\x22'))
+            {
+                if(! sc.quoted('\x22', out))
+                    return fail(error::syntax);
+            }
+            else
+            {
+                seg.k = segment::kind::slice;
+                bool const has_start =
+                    sc.number(seg.start);
+                if(! sc.skip(':'))
+                {
+                    // single index
+                    if(! has_start)
+                        return fail(error::syntax);
+                    seg.end = seg.start + 1;
+                    if(seg.end == 0)
+                        seg.end = seg.start;
+                }
+                else
+                {
+                    sc.number(seg.end);
+                    if( sc.skip(':') &&
+                        sc.number(seg.step) &&
+                        seg.step == 0)
+                        return fail(error::syntax);
+                }
+            }
+            if(! sc.skip(']'))
+                return fail(error::syntax);
+        }
+        seg.size = out - base - seg.offset;
+        ++count;
+    }
+
+    release();
+    s_ = segs;
+    n_ = count;
+    bytes_ = bytes;
+    ec = {};
+}
+
+void
+json_path::
+release() noexcept
+{
+    if(s_)
+        sp_->deallocate(s_, bytes_,
+            alignof(segment));
+    s_ = nullptr;
+    n_ = 0;
+    bytes_ = 0;
+}
+
+char const*
+json_path::
+text() const noexcept
+{
+    return reinterpret_cast<
+        char const*>(s_);
+}
+
+BOOST_JSON_NS_END
+
+#endif
@@ -0,0 +1,401 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_JSON_POINTER_IPP
+#define BOOST_JSON_IMPL_JSON_POINTER_IPP
+
+#include <boost/json/json_pointer.hpp>
+#include <boost/json/detail/except.hpp>
+#include <cstring>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+
+struct json_pointer::token
+{
+    // index values which are not array positions
+    static constexpr std::size_t no_index = std::size_t(-1);
+    static constexpr std::size_t end_index = std::size_t(-2);
+
+    std::size_t offset; // into decoded text
+    std::size_t size;
+    std::size_t index;
+};
+
+//----------------------------------------------------------
+
+json_pointer::
+~json_pointer()
+{
+    release();
+}
+
+json_pointer::
+json_pointer(
+    string_view s,
+    storage_ptr sp)
+    : sp_(std::move(sp))
+{
+    error_code ec;
+    parse(s, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+}
+
+json_pointer::
+json_pointer(
+    string_view s,
+    error_code& ec,
+    storage_ptr sp)
+    : sp_(std::move(sp))
+{
+    parse(s, ec);
+}
+
+json_pointer::
+json_pointer(json_pointer const& other)
+    : sp_(other.sp_)
+{
+    if(! other.t_)
+        return;
+    t_ = static_cast<token*>(
+        sp_->allocate(other.bytes_,
+            alignof(token)));
+    std::memcpy(t_, other.t_, other.bytes_);
+    n_ = other.n_;
+    bytes_ = other.bytes_;
+}
+
+json_pointer::
+json_pointer(json_pointer&& other) noexcept
+    : sp_(other.sp_)
+    , t_(other.t_)
+    , n_(other.n_)
+    , bytes_(other.bytes_)
+{
+    other.t_ = nullptr;
+    other.n_ = 0;
+    other.bytes_ = 0;
+}
+
+json_pointer&
+json_pointer::
+operator=(json_pointer const& other)
+{
+    if(this == &other)
+        return *this;
+    token* t = nullptr;
+    if(other.t_)
+    {
+        // copy into our resource
+        t = static_cast<token*>(
+            sp_->allocate(other.bytes_,
+                alignof(token)));
+        std::memcpy(t, other.t_, other.bytes_);
+    }
+    release();
+    t_ = t;
+    n_ = other.n_;
+    bytes_ = other.bytes_;
+    return *this;
+}
+
+json_pointer&
+json_pointer::
+operator=(json_pointer&& other)
+{
+    if(*sp_ != *other.sp_)
+        return *this = static_cast<
+            json_pointer const&>(other);
+    release();
+    t_ = other.t_;
+    n_ = other.n_;
+    bytes_ = other.bytes_;
+    other.t_ = nullptr;
+    other.n_ = 0;
+    other.bytes_ = 0;
+    return *this;
+}
+
+string_view
+json_pointer::
+operator[](std::size_t pos) const noexcept
+{
+    BOOST_ASSERT(pos < n_);
+    return { text() + t_[pos].offset,
+        t_[pos].size };
+}
+
+value const*
+json_pointer::
+find(
+    value const& jv,
+    error_code& ec) const noexcept
+{
+    value const* p = &jv;
+    for(auto t = t_, last = t_ + n_;
+        t != last; ++t)
+    {
+        switch(p->kind())
+        {
+        case kind::object:
+        {
+            auto const v =
+                p->get_object().if_contains(
+                    { text() + t->offset, t->size });
+            if(! v)
+            {
+                ec = error::not_found;
+                return nullptr;
+            }
+            p = v;
+            break;
+        }
+
+        case kind::array:
+        {
+            auto const& arr = p->get_array();
+            if(t->index == token::no_index)
+            {
+                ec = error::token_not_number;
+                return nullptr;
+            }
+            if(t->index >= arr.size())
+            {
+                ec = error::not_found;
+                return nullptr;
+            }
+            p = &arr[t->index];
+            break;
+        }
+
+        default:
+            ec = error::value_is_scalar;
+            return nullptr;
+        }
+    }
+    ec = {};
+    return p;
+}
+
+value const&
+json_pointer::
+at(value const& jv) const
+{
+    error_code ec;
+    auto const p = find(jv, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    return *p;
+}
+
+value*
+json_pointer::
+emplace(
+    value& jv,
+    error_code& ec) const
+{
+    value* p = &jv;
+    for(auto t = t_, last = t_ + n_;
+        t != last; ++t)
+    {
+        if(p->is_null())
+        {
+            if(t->index != token::no_index)
+                p->emplace_array();
+            else
+                p->emplace_object();
+        }
+        switch(p->kind())
+        {
+        case kind::object:
+        {
+            auto& obj = p->get_object();
+            string_view const key(
+                text() + t->offset, t->size);
+            auto const v =
+                obj.if_contains(key);
+            if(v)
+                p = v;
+            else
+                p = &obj.emplace(
+                    key, nullptr).first->value();
+            break;
+        }
+
+        case kind::array:
+        {
+            auto& arr = p->get_array();
+            if(t->index == token::no_index)
+            {
+                ec = error::token_not_number;
+                return nullptr;
+            }
+            if( t->index == token::end_index ||
+                t->index == arr.size())
+            {
+                arr.emplace_back(nullptr);
+                p = &arr.back();
+                break;
+            }
+            if(t->index > arr.size())
+            {
+                ec = error::not_found;
+                return nullptr;
+            }
+            p = &arr[t->index];
+            break;
+        }
+
+        default:
+            ec = error::value_is_scalar;
+            return nullptr;
+        }
+    }
+    ec = {};
+    return p;
+}
+
+value&
+json_pointer::
+emplace(value& jv) const
+{
+    error_code ec;
+    auto const p = emplace(jv, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    return *p;
+}
+
+//----------------------------------------------------------
+
+void
+json_pointer::
+parse(
+    string_view s,
+    error_code& ec)
+{
+    if(s.empty())
+    {
+        ec = {};
+        return;
+    }
+    if(s[0] != '/')
+    {
+        ec = error::missing_slash;
+        return;
+    }
+
+    // count the tokens and check the escapes
+    std::size_t n = 0;
+    for(std::size_t i = 0; i < s.size(); ++i)
+    {
+        if(s[i] == '/')
+            ++n;
+        else if(s[i] == '~' && (
+            i + 1 == s.size() || (
+                s[i + 1] != '0' &&
+                s[i + 1] != '1')))
+        {
+            ec = error::invalid_escape;
+            return;
+        }
+    }
+
+    // the decoded text is never
+    // longer than the pointer
+    std::size_t const bytes =
+        n * sizeof(token) + s.size();
+    auto const t = static_cast<token*>(
+        sp_->allocate(bytes, alignof(token)));
+    char* const base = reinterpret_cast<
+        char*>(t + n);
+    char* out = base;
+    auto it = s.data() + 1;
+    auto const end = s.data() + s.size();
+    for(std::size_t i = 0; i < n; ++i)
+    {
+        token& tk = t[i];
+        tk.offset = out - base;
+        auto const first = out;
+        while(it != end && *it != '/')
+        {
+            if(*it != '~')
+            {
+                *out++ = *it++;
+                continue;
+            }
+            *out++ = it[1] == '0' ? '~' : '/';
+            it += 2;
+        }
+        ++it; // '/'
+        tk.size = out - first;
+
+        // array-index = %x30 / ( %x31-39 *(%x30-39) )
+        tk.index = token::no_index;
+        if(tk.size == 1 && *first == '-')
+        {
+            tk.index = token::end_index;
+        }
+        else if(tk.size > 0 &&
+            static_cast<unsigned char>(*first - '0') < 10 &&
+            (*first != '0' || tk.size == 1))
+        {
+            std::size_t v = 0;
+            auto p = first;
+            for(; p != out; ++p)
+            {
+                unsigned const d =
+                    static_cast<unsigned char>(*p - '0');
+                if(d > 9)
+                    break;
+                // an index too large for any array
+                // will never be found
+                if(v > (std::size_t(-3) - d) / 10)
+                    v = std::size_t(-3);
+                else
+                    v = 10 * v + d;
+            }
+            if(p == out)
+                tk.index = v;
+        }
+    }
+
+    release();
+    t_ = t;
+    n_ = n;
+    bytes_ = bytes;
+    ec = {};
+}
+
+void
+json_pointer::
+release() noexcept
+{
+    if(t_)
+        sp_->deallocate(t_, bytes_, alignof(token));
+    t_ = nullptr;
+    n_ = 0;
+    bytes_ = 0;
+}
+
+char const*
+json_pointer::
+text() const noexcept
+{
+    return reinterpret_cast<
+        char const*>(t_ + n_);
+}
+
+BOOST_JSON_NS_END
+
+#endif
@@ -0,0 +1,684 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_JSON_SCHEMA_IPP
+#define BOOST_JSON_IMPL_JSON_SCHEMA_IPP
+
+#include <boost/json/json_schema.hpp>
+#include <boost/json/detail/digest.hpp>
+#include <boost/json/detail/except.hpp>
+#include <cstring>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+
+/*  A schema is compiled in two passes. The first
+    checks every keyword and counts the nodes,
+    properties and name characters, so that the
+    second can lay them out in a single allocation
+    in which everything is addressed by index.
+*/
+class json_schema::compiler
+{
+    node* n_;
+    property* p_;
+    char* base_;
+    char* text_;
+    std::size_t nn_ = 0;
+    std::size_t np_ = 0;
+
+public:
+    std::size_t nodes = 0;
+    std::size_t props = 0;
+    std::size_t chars = 0;
+
+    void
+    attach(char* base) noexcept
+    {
+        n_ = reinterpret_cast<node*>(base);
+        p_ = reinterpret_cast<property*>(n_ + nodes);
+        base_ = base;
+        text_ = reinterpret_cast<char*>(p_ + props);
+    }
+
+    static
+    bool
+    is_size(value const& jv) noexcept
+    {
+        if(jv.is_uint64())
+            return true;
+        if(jv.is_int64())
+            return jv.get_int64() >= 0;
+        if(jv.is_double())
+            return jv.get_double() >= 0 &&
+                std::floor(jv.get_double()) ==
+                    jv.get_double();
+        return false;
+    }
+
+    static
+    std::size_t
+    to_size(value const& jv) noexcept
+    {
+        if(jv.is_double())
+        {
+            if(jv.get_double() >= 18446744073709551615.0)
+                return std::size_t(-1);
+            return static_cast<std::size_t>(
+                static_cast<std::uint64_t>(
+                    jv.get_double()));
+        }
+        std::uint64_t const u = jv.is_uint64() ?
+            jv.get_uint64() : static_cast<
+                std::uint64_t>(jv.get_int64());
+        if(u >= std::size_t(-1))
+            return std::size_t(-1);
+        return static_cast<std::size_t>(u);
+    }
+
+    static
+    bound
+    to_bound(value const& jv) noexcept
+    {
+        bound b;
+        b.k = jv.kind();
+        if(b.k == kind::int64)
+            b.i = jv.get_int64();
+        else if(b.k == kind::uint64)
+            b.u = jv.get_uint64();
+        else
+            b.d = jv.get_double();
+        return b;
+    }
+
+    static
+    unsigned
+    to_type(value const& jv) noexcept
+    {
+        if(! jv.is_string())
+            return 0;
+        string_view const s = jv.get_string();
+        if(s == "null")
+            return null_type;
+        if(s == "boolean")
+            return boolean_type;
+        if(s == "integer")
+            return integer_type;
+        if(s == "number")
+            return integer_type | fraction_type;
+        if(s == "string")
+            return string_type;
+        if(s == "array")
+            return array_type;
+        if(s == "object")
+            return object_type;
+        return 0;
+    }
+
+    // check and count a schema
+    bool
+    measure(value const& s) noexcept
+    {
+        if(s.is_bool())
+        {
+            if(! s.get_bool())
+                ++nodes;
+            return true;
+        }
+        if(! s.is_object())
+            return false;
+        ++nodes;
+        object const& obj = s.get_object();
+        auto const props_of = obj.if_contains("properties");
+        for(auto const& kv : obj)
+        {
+            string_view const k = kv.key();
+            value const& v = kv.value();
+            if(k == "type")
+            {
+                if(v.is_array())
+                {
+                    if(v.get_array().empty())
+                        return false;
+                    for(auto const& t : v.get_array())
+                        if(! to_type(t))
+                            return false;
+                }
+                else if(! to_type(v))
+                {
+                    return false;
+                }
+            }
+            else if(k == "properties")
+            {
+                if(! v.is_object())
+                    return false;
+                for(auto const& p : v.get_object())
+                {
+                    ++props;
+                    chars += p.key().size();
+                    if(! measure(p.value()))
+                        return false;
+                }
+            }
+            else if(k == "required")
+            {
+                if(! v.is_array())
+                    return false;
+                array const& arr = v.get_array();
+                if(arr.size() > 64)
+                    return false;
+                for(std::size_t i = 0; i < arr.size(); ++i)
+                {
+                    if(! arr[i].is_string())
+                        return false;
+                    for(std::size_t j = 0; j < i; ++j)
+                        if(arr[j] == arr[i])
+                            return false;
+                    string_view const name =
+                        arr[i].get_string();
+                    if( props_of &&
+                        props_of->is_object() &&
+                        props_of->get_object().contains(name))
+                        continue;
+                    ++props;
+                    chars += name.size();
+                }
+            }
+            else if(
+                k == "additionalProperties" ||
+                k == "items")
+            {
+                if(! measure(v))
+                    return false;
+            }
+            else if(
+                k == "minimum" ||
+                k == "maximum" ||
+                k == "exclusiveMinimum" ||
+                k == "exclusiveMaximum")
+            {
+                if(! v.is_number())
+                    return false;
+            }
+            else if(
+                k == "minLength" ||
+                k == "maxLength" ||
+                k == "minItems" ||
+                k == "maxItems" ||
+                k == "minProperties" ||
+                k == "maxProperties")
+            {
+                if(! is_size(v))
+                    return false;
+            }
+            else if(
+                k != "$schema" &&
+                k != "$id" &&
+                k != "$comment" &&
+                k != "title" &&
+                k != "description" &&
+                k != "default" &&
+                k != "examples")
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    property&
+    add_property(
+        node& nd,
+        string_view name) noexcept
+    {
+        property& p = p_[nd.props + nd.nprops++];
+        p.hash = detail::digest(
+            name.data(), name.size());
+        p.offset = text_ - base_;
+        p.size = name.size();
+        p.schema = any;
+        p.bit = any;
+        std::memcpy(text_, name.data(), name.size());
+        text_ += name.size();
+        return p;
+    }
+
+    // lay out a schema which has been measured
+    std::size_t
+    build(value const& s) noexcept
+    {
+        if(s.is_bool() && s.get_bool())
+            return any;
+        std::size_t const i = nn_++;
+        node& nd = n_[i];
+        nd.props = 0;
+        nd.nprops = 0;
+        nd.nrequired = 0;
+        nd.items = any;
+        nd.additional = any;
+        nd.min_length = 0;
+        nd.max_length = std::size_t(-1);
+        nd.min_items = 0;
+        nd.max_items = std::size_t(-1);
+        nd.min_props = 0;
+        nd.max_props = std::size_t(-1);
+        nd.minimum.k = kind::int64;
+        nd.minimum.i = 0;
+        nd.maximum = nd.minimum;
+        nd.types = all_types;
+        nd.has_minimum = false;
+        nd.has_maximum = false;
+        nd.exclusive_minimum = false;
+        nd.exclusive_maximum = false;
+        if(s.is_bool())
+        {
+            nd.types = 0;
+            return i;
+        }
+        object const& obj = s.get_object();
+
+        // properties come first, so that
+        // required names can find them.
+        nd.props = np_;
+        auto const properties =
+            obj.if_contains("properties");
+        auto const required =
+            obj.if_contains("required");
+        if(properties)
+            np_ += properties->get_object().size();
+        if(required)
+        {
+            for(auto const& name : required->get_array())
+                if(! properties || ! properties->
+                    get_object().contains(name.get_string()))
+                    ++np_;
+        }
+        if(properties)
+        {
+            for(auto const& kv : properties->get_object())
+            {
+                // `nd` stays valid, the
+                // nodes are preallocated
+                add_property(nd, kv.key()).schema =
+                    build(kv.value());
+            }
+        }
+        if(required)
+        {
+            for(auto const& name : required->get_array())
+            {
+                string_view const key = name.get_string();
+                property* p = nullptr;
+                for(std::size_t j = 0; j < nd.nprops; ++j)
+                {
+                    property& q = p_[nd.props + j];
+                    if(string_view(base_ + q.offset,
+                            q.size) == key)
+                    {
+                        p = &q;
+                        break;
+                    }
+                }
+                if(! p)
+                    p = &add_property(nd, key);
+                p->bit = nd.nrequired++;
+            }
+        }
+
+        for(auto const& kv : obj)
+        {
+            string_view const k = kv.key();
+            value const& v = kv.value();
+            if(k == "type")
+            {
+                if(v.is_array())
+                {
+                    nd.types = 0;
+                    for(auto const& t : v.get_array())
+                        nd.types |= to_type(t);
+                }
+                else
+                {
+                    nd.types = to_type(v);
+                }
+            }
+            else if(k == "additionalProperties")
+            {
+                nd.additional = build(v);
+            }
+            else if(k == "items")
+            {
+                nd.items = build(v);
+            }
+            else if(
+                k == "minimum" ||
+                k == "exclusiveMinimum")
+            {
+                bound const b = to_bound(v);
+                bool const exclusive =
+                    k == "exclusiveMinimum";
+                int const c = nd.has_minimum ?
+                    b.compare(nd.minimum) : 1;
+                if(c > 0 || (c == 0 && exclusive))
+                {
+                    nd.minimum = b;
+                    nd.has_minimum = true;
+                    nd.exclusive_minimum = exclusive;
+                }
+            }
+            else if(
+                k == "maximum" ||
+                k == "exclusiveMaximum")
+            {
+                bound const b = to_bound(v);
+                bool const exclusive =
+                    k == "exclusiveMaximum";
+                int const c = nd.has_maximum ?
+                    b.compare(nd.maximum) : -1;
+                if(c < 0 || (c == 0 && exclusive))
+                {
+                    nd.maximum = b;
+                    nd.has_maximum = true;
+                    nd.exclusive_maximum = exclusive;
+                }
+            }
+            else if(k == "minLength")
+                nd.min_length = to_size(v);
+            else if(k == "maxLength")
+                nd.max_length = to_size(v);
+            else if(k == "minItems")
+                nd.min_items = to_size(v);
+            else if(k == "maxItems")
+                nd.max_items = to_size(v);
+            else if(k == "minProperties")
+                nd.min_props = to_size(v);
+            else if(k == "maxProperties")
+                nd.max_props = to_size(v);
+        }
+        return i;
+    }
+};
+
+//----------------------------------------------------------
+
+json_schema::
+~json_schema()
+{
+    release();
+}
+
+json_schema::
+json_schema(
+    value const& schema,
+    storage_ptr sp)
+    : sp_(std::move(sp))
+{
+    error_code ec;
+    compile(schema, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+}
+
+json_schema::
+json_schema(
+    value const& schema,
+    error_code& ec,
+    storage_ptr sp)
+    : sp_(std::move(sp))
+{
+    compile(schema, ec);
+}
+
+json_schema::
+json_schema(json_schema const& other)
+    : sp_(other.sp_)
+{
+    if(! other.n_)
+        return;
+    n_ = static_cast<node*>(
+        sp_->allocate(other.bytes_,
+            alignof(node)));
+    std::memcpy(n_, other.n_, other.bytes_);
+    size_ = other.size_;
+    bytes_ = other.bytes_;
+}
+
+json_schema::
+json_schema(json_schema&& other) noexcept
+    : sp_(other.sp_)
+    , n_(other.n_)
+    , size_(other.size_)
+    , bytes_(other.bytes_)
+{
+    other.n_ = nullptr;
+    other.size_ = 0;
+    other.bytes_ = 0;
+}
+
+json_schema&
+json_schema::
+operator=(json_schema const& other)
+{
+    if(this == &other)
+        return *this;
+    node* n = nullptr;
+    if(other.n_)
+    {
+        // copy into our resource
+        n = static_cast<node*>(
+            sp_->allocate(other.bytes_,
+                alignof(node)));
+        std::memcpy(n, other.n_, other.bytes_);
+    }
+    release();
+    n_ = n;
+    size_ = other.size_;
+    bytes_ = other.bytes_;
+    return *this;
+}
+
+json_schema&
+json_schema::
+operator=(json_schema&& other)
+{
+    if(*sp_ != *other.sp_)
+        return *this = static_cast<
+            json_schema const&>(other);
+    release();
+    n_ = other.n_;
+    size_ = other.size_;
+    bytes_ = other.bytes_;
+    other.n_ = nullptr;
+    other.size_ = 0;
+    other.bytes_ = 0;
+    return *this;
+}
+
+void
+json_schema::
+validate(
+    value const& jv,
+    error_code& ec) const noexcept
+{
+    ec = {};
+    check(root(), jv, ec);
+}
+
+void
+json_schema::
+validate(value const& jv) const
+{
+    error_code ec;
+    validate(jv, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+}
+
+//----------------------------------------------------------
+
+auto
+json_schema::
+find(
+    node const& nd,
+    string_view key) const noexcept ->
+        property const*
+{
+    if(nd.nprops == 0)
+        return nullptr;
+    auto const hash = detail::digest(
+        key.data(), key.size());
+    for(std::size_t i = 0; i < nd.nprops; ++i)
+    {
+        property const& p = prop(nd.props + i);
+        if( p.hash == hash &&
+            key == string_view(
+                text() + p.offset, p.size))
+            return &p;
+    }
+    return nullptr;
+}
+
+bool
+json_schema::
+check(
+    std::size_t i,
+    value const& jv,
+    error_code& ec) const noexcept
+{
+    if(i == any)
+        return true;
+    node const& nd = at(i);
+    auto const fail = [&ec](error e)
+    {
+        ec = e;
+        return false;
+    };
+    switch(jv.kind())
+    {
+    case kind::null:
+        if(! (nd.types & null_type))
+            return fail(error::type_mismatch);
+        return true;
+
+    case kind::bool_:
+        if(! (nd.types & boolean_type))
+            return fail(error::type_mismatch);
+        return true;
+
+    case kind::int64:
+    case kind::uint64:
+    case kind::double_:
+        return nd.check_number(
+            compiler::to_bound(jv), ec);
+
+    case kind::string:
+    {
+        if(! (nd.types & string_type))
+            return fail(error::type_mismatch);
+        auto const n = code_points(jv.get_string());
+        if(n < nd.min_length || n > nd.max_length)
+            return fail(error::size_out_of_range);
+        return true;
+    }
+
+    case kind::array:
+    {
+        if(! (nd.types & array_type))
+            return fail(error::type_mismatch);
+        array const& arr = jv.get_array();
+        for(auto const& e : arr)
+            if(! check(nd.items, e, ec))
+                return false;
+        if( arr.size() < nd.min_items ||
+            arr.size() > nd.max_items)
+            return fail(error::size_out_of_range);
+        return true;
+    }
+
+    case kind::object:
+    {
+        if(! (nd.types & object_type))
+            return fail(error::type_mismatch);
+        object const& obj = jv.get_object();
+        std::uint64_t seen = 0;
+        for(auto const& kv : obj)
+        {
+            std::size_t sub = nd.additional;
+            auto const p = find(nd, kv.key());
+            if(p)
+            {
+                sub = p->schema;
+                if(p->bit != any)
+                    seen |= std::uint64_t(1) << p->bit;
+            }
+            else if(rejects(sub))
+            {
+                return fail(error::additional_property);
+            }
+            if(! check(sub, kv.value(), ec))
+                return false;
+        }
+        if(nd.nrequired && seen != (
+            ~std::uint64_t(0) >> (64 - nd.nrequired)))
+            return fail(error::required_missing);
+        if( obj.size() < nd.min_props ||
+            obj.size() > nd.max_props)
+            return fail(error::size_out_of_range);
+        return true;
+    }
+    }
+    return true;
+}
+
+void
+json_schema::
+compile(
+    value const& schema,
+    error_code& ec)
+{
+    compiler c;
+    if(! c.measure(schema))
+    {
+        ec = error::invalid_schema;
+        return;
+    }
+    ec = {};
+    if(c.nodes == 0)
+        return;
+    std::size_t const bytes =
+        c.nodes * sizeof(node) +
+        c.props * sizeof(property) +
+        c.chars;
+    char* const base = static_cast<char*>(
+        sp_->allocate(bytes, alignof(node)));
+    c.attach(base);
+    c.build(schema);
+    n_ = reinterpret_cast<node*>(base);
+    size_ = c.nodes;
+    bytes_ = bytes;
+}
+
+void
+json_schema::
+release() noexcept
+{
+    if(n_)
+        sp_->deallocate(n_, bytes_,
+            alignof(node));
+    n_ = nullptr;
+    size_ = 0;
+    bytes_ = 0;
+}
+
+BOOST_JSON_NS_END
+
+#endif
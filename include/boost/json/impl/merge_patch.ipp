@@ -0,0 +1,116 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_MERGE_PATCH_IPP
+#define BOOST_JSON_IMPL_MERGE_PATCH_IPP
+
+#include <boost/json/merge_patch.hpp>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+// Remove the null members of `obj` and of the
+// objects it holds, but not those in arrays.
+// This turns a copy of a patch into the result
+// of merging the patch into an empty object.
+inline
+void
+remove_nulls(object& obj) noexcept
+{
+    for(auto it = obj.begin(); it != obj.end();)
+    {
+        auto& jv = it->value();
+        if(jv.is_null())
+        {
+            // the last member moves here
+            it = obj.erase(it);
+            continue;
+        }
+        if(jv.is_object())
+            remove_nulls(jv.get_object());
+        ++it;
+    }
+}
+
+inline
+void
+assign_patch(
+    value& target,
+    value const& patch)
+{
+    target = patch;
+}
+
+inline
+void
+assign_patch(
+    value& target,
+    value& patch)
+{
+    target = std::move(patch);
+}
+
+// Patch is `value const` to copy from
+// the patch, or `value` to move from it
+template<class Patch>
+void
+merge_patch_impl(
+    value& target,
+    Patch& patch)
+{
+    if(! patch.is_object())
+    {
+        assign_patch(target, patch);
+        return;
+    }
+    if(! target.is_object())
+    {
+        // Take the whole patch and remove its
+        // nulls in one pass, rather than merging
+        // it member by member into a new object.
+        assign_patch(target, patch);
+        remove_nulls(target.get_object());
+        return;
+    }
+    auto& to = target.get_object();
+    for(auto& kv : patch.get_object())
+    {
+        auto& jv = kv.value();
+        if(jv.is_null())
+            to.erase(kv.key());
+        else
+            merge_patch_impl(
+                to[kv.key()], jv);
+    }
+}
+
+} // detail
+
+void
+merge_patch(
+    value& target,
+    value const& patch)
+{
+    detail::merge_patch_impl(
+        target, patch);
+}
+
+void
+merge_patch(
+    value& target,
+    value&& patch)
+{
+    detail::merge_patch_impl(
+        target, patch);
+}
+
+BOOST_JSON_NS_END
+
+#endif
@@ -749,13 +749,29 @@ equal(object const& other) const noexcept
 {
     if(size() != other.size())
         return false;
-    auto const end_ = other.end();
-    for(auto e : *this)
+    // Objects built the same way usually have
+    // their members in the same order, which
+    // can be compared without any lookups.
+    auto it0 = begin();
+    auto const end0 = end();
+    auto it1 = other.begin();
+    for(; it0 != end0; ++it0, ++it1)
     {
-        auto it = other.find(e.key());
-        if(it == end_)
+        if(it0->key() != it1->key())
+            break;
+        if(it0->value() != it1->value())
+            return false;
+    }
+    // The keys are unique and the sizes
+    // are equal, so finding every remaining
+    // key means the sets of keys are equal.
+    auto const end1 = other.end();
+    for(; it0 != end0; ++it0)
+    {
+        auto const it = other.find(it0->key());
+        if(it == end1)
             return false;
-        if(it->value() != e.value())
+        if(it->value() != it0->value())
             return false;
     }
     return true;
@@ -14,6 +14,7 @@
 #include <boost/json/parse.hpp>
 #include <boost/json/parser.hpp>
 #include <boost/json/detail/except.hpp>
+#include <boost/json/detail/mapped_file.hpp>
 
 BOOST_JSON_NS_BEGIN
 
@@ -49,6 +50,36 @@ parse(
     return jv;
 }
 
+value
+parse_file(
+    char const* path,
+    error_code& ec,
+    storage_ptr sp,
+    const parse_options& opt)
+{
+    detail::mapped_file f;
+    f.open(path, ec);
+    if(ec)
+        return nullptr;
+    return parse(f.view(),
+        ec, std::move(sp), opt);
+}
+
+value
+parse_file(
+    char const* path,
+    storage_ptr sp,
+    const parse_options& opt)
+{
+    error_code ec;
+    auto jv = parse_file(
+        path, ec, std::move(sp), opt);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    return jv;
+}
+
 BOOST_JSON_NS_END
 
 #endif
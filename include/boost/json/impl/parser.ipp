@@ -12,6 +12,7 @@
 
 #include <boost/json/parser.hpp>
 #include <boost/json/basic_parser_impl.hpp>
+#include <boost/json/detail/trace.hpp>
 #include <boost/json/error.hpp>
 #include <cstring>
 #include <stdexcept>
@@ -62,9 +63,11 @@ write_some(
     std::size_t size,
     error_code& ec)
 {
+    BOOST_JSON_TRACE_SPAN(span, parse, size);
     auto const n = p_.write_some(
         false, data, size, ec);
     BOOST_ASSERT(ec || p_.done());
+    BOOST_JSON_TRACE_RESULT(span, n);
     return n;
 }
 
@@ -0,0 +1,118 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_PATH_PARSER_IPP
+#define BOOST_JSON_IMPL_PATH_PARSER_IPP
+
+#include <boost/json/path_parser.hpp>
+#include <boost/json/basic_parser_impl.hpp>
+#include <boost/json/error.hpp>
+#include <utility>
+
+BOOST_JSON_NS_BEGIN
+
+path_parser::
+path_parser(
+    json_path const& path,
+    storage_ptr sp,
+    parse_options const& opt)
+    : p_(
+        opt,
+        path,
+        std::move(sp))
+{
+}
+
+void
+path_parser::
+reset() noexcept
+{
+    p_.reset();
+    p_.handler().reset();
+}
+
+std::size_t
+path_parser::
+write_some(
+    char const* data,
+    std::size_t size,
+    error_code& ec)
+{
+    return p_.write_some(
+        true, data, size, ec);
+}
+
+std::size_t
+path_parser::
+write_some(
+    char const* data,
+    std::size_t size)
+{
+    error_code ec;
+    auto const n = write_some(
+        data, size, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    return n;
+}
+
+std::size_t
+path_parser::
+write(
+    char const* data,
+    std::size_t size,
+    error_code& ec)
+{
+    auto const n = write_some(
+        data, size, ec);
+    if(! ec && n < size)
+    {
+        ec = error::extra_data;
+        p_.fail(ec);
+    }
+    return n;
+}
+
+std::size_t
+path_parser::
+write(
+    char const* data,
+    std::size_t size)
+{
+    error_code ec;
+    auto const n = write(
+        data, size, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    return n;
+}
+
+void
+path_parser::
+finish(error_code& ec)
+{
+    p_.write_some(false, nullptr, 0, ec);
+}
+
+void
+path_parser::
+finish()
+{
+    error_code ec;
+    finish(ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+}
+
+BOOST_JSON_NS_END
+
+#endif
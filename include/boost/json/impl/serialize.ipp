@@ -111,6 +111,42 @@ serialize(
     return s;
 }
 
+std::string
+serialize(
+    value const& jv,
+    serialize_options const& opts)
+{
+    std::string s;
+    serializer sr(opts);
+    sr.reset(&jv);
+    serialize_impl(s, sr);
+    return s;
+}
+
+std::string
+serialize(
+    array const& arr,
+    serialize_options const& opts)
+{
+    std::string s;
+    serializer sr(opts);
+    sr.reset(&arr);
+    serialize_impl(s, sr);
+    return s;
+}
+
+std::string
+serialize(
+    object const& obj,
+    serialize_options const& opts)
+{
+    std::string s;
+    serializer sr(opts);
+    sr.reset(&obj);
+    serialize_impl(s, sr);
+    return s;
+}
+
 //----------------------------------------------------------
 
 //[example_operator_lt__lt_
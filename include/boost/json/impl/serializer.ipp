@@ -13,6 +13,8 @@
 #include <boost/json/serializer.hpp>
 #include <boost/json/detail/format.hpp>
 #include <boost/json/detail/sse2.hpp>
+#include <boost/json/detail/trace.hpp>
+#include <algorithm>
 #include <ostream>
 
 #ifdef _MSC_VER
@@ -73,6 +75,102 @@ suspend(
     return false;
 }
 
+bool
+serializer::
+suspend(
+    state st,
+    std::size_t i,
+    std::size_t base,
+    object const* po)
+{
+    st_.push(po);
+    st_.push(base);
+    st_.push(i);
+    st_.push(st);
+    return false;
+}
+
+namespace detail {
+
+// Returns true if `a` comes before `b` in the
+// order of their UTF-16 code units, which RFC 8785
+// uses for keys. This is the order of the UTF-8
+// bytes, except that U+E000 to U+FFFF come after
+// the characters above U+FFFF, whose surrogates
+// are in the range U+D800 to U+DFFF.
+inline
+bool
+canonical_less(
+    string_view a,
+    string_view b) noexcept
+{
+    auto const n = (std::min)(
+        a.size(), b.size());
+    std::size_t i = 0;
+    while(i < n && a[i] == b[i])
+        ++i;
+    if(i == n)
+        return a.size() < b.size();
+    auto const ca = static_cast<
+        unsigned char>(a[i]);
+    auto const cb = static_cast<
+        unsigned char>(b[i]);
+    // both are leading bytes of
+    // three or four byte sequences
+    if(ca >= 0xEE && cb >= 0xEE)
+    {
+        bool const sa = ca >= 0xF0;
+        bool const sb = cb >= 0xF0;
+        if(sa != sb)
+            return sa;
+    }
+    return ca < cb;
+}
+
+} // detail
+
+// Push pointers to the members of the object in
+// canonical order on perm_, and return the index
+// of the first one.
+std::size_t
+serializer::
+sort_members(object const* po)
+{
+    using pointer = key_value_pair const*;
+    auto const base =
+        perm_.size() / sizeof(pointer);
+    auto const n = po->size();
+    auto const size =
+        perm_.size() + n * sizeof(pointer);
+    if(perm_.capacity() < size)
+        perm_.reserve((std::max)(
+            2 * perm_.capacity(), size));
+    for(auto const& kv : *po)
+        perm_.push_unchecked(&kv);
+    auto const first = reinterpret_cast<
+        pointer*>(perm_.data()) + base;
+    std::sort(first, first + n,
+        [](pointer lhs, pointer rhs)
+        {
+            return detail::canonical_less(
+                lhs->key(), rhs->key());
+        });
+    return base;
+}
+
+key_value_pair const*
+serializer::
+member(
+    std::size_t base,
+    std::size_t i) noexcept
+{
+    // perm_ can be reallocated by nested
+    // objects, so the index is kept instead
+    return reinterpret_cast<
+        key_value_pair const* const*>(
+            perm_.data())[base + i];
+}
+
 template<bool StackEmpty>
 bool
 serializer::
@@ -390,10 +488,54 @@ write_number(stream& ss0)
     local_stream ss(ss0);
     if(StackEmpty || st_.empty())
     {
+        if(BOOST_JSON_UNLIKELY(opts_.canonical))
+        {
+            // integers up to 2^53 are exact as
+            // doubles, and format the same way
+            double d;
+            switch(jv_->kind())
+            {
+            default:
+            case kind::int64:
+            {
+                auto const i = jv_->get_int64();
+                if( i <= (std::int64_t(1) << 53) &&
+                    i >= -(std::int64_t(1) << 53))
+                    goto do_int64;
+                d = static_cast<double>(i);
+                break;
+            }
+
+            case kind::uint64:
+            {
+                auto const u = jv_->get_uint64();
+                if(u <= (std::uint64_t(1) << 53))
+                    goto do_uint64;
+                d = static_cast<double>(u);
+                break;
+            }
+
+            case kind::double_:
+                d = jv_->get_double();
+                break;
+            }
+            if(BOOST_JSON_LIKELY(
+                ss.remain() >=
+                    detail::max_number_chars))
+            {
+                ss.advance(detail::format_double_canonical(
+                    ss.data(), d));
+                return true;
+            }
+            cs0_ = { buf_, detail::format_double_canonical(
+                buf_, d) };
+            goto do_num;
+        }
         switch(jv_->kind())
         {
         default:
         case kind::int64:
+        do_int64:
             if(BOOST_JSON_LIKELY(
                 ss.remain() >=
                     detail::max_number_chars))
@@ -407,6 +549,7 @@ write_number(stream& ss0)
             break;
 
         case kind::uint64:
+        do_uint64:
             if(BOOST_JSON_LIKELY(
                 ss.remain() >=
                     detail::max_number_chars))
@@ -440,6 +583,7 @@ write_number(stream& ss0)
         BOOST_ASSERT(
             st == state::num);
     }
+do_num:
     auto const n = ss.remain();
     if(n < cs0_.remain())
     {
@@ -603,6 +747,100 @@ do_obj6:
         state::obj6, it, po);
 }
 
+// Same as write_object, but the members
+// are visited in canonical order.
+template<bool StackEmpty>
+bool
+serializer::
+write_sorted(stream& ss0)
+{
+    object const* po;
+    local_stream ss(ss0);
+    std::size_t base;
+    std::size_t i;
+    std::size_t n;
+    key_value_pair const* kv;
+    if(StackEmpty || st_.empty())
+    {
+        po = po_;
+        base = sort_members(po);
+        i = 0;
+        n = po->size();
+    }
+    else
+    {
+        state st;
+        st_.pop(st);
+        st_.pop(i);
+        st_.pop(base);
+        st_.pop(po);
+        n = po->size();
+        switch(st)
+        {
+        default:
+        case state::obj1: goto do_obj1;
+        case state::obj2: goto do_obj2;
+        case state::obj3: goto do_obj3;
+        case state::obj4: goto do_obj4;
+        case state::obj5: goto do_obj5;
+        case state::obj6: goto do_obj6;
+            break;
+        }
+    }
+do_obj1:
+    if(BOOST_JSON_LIKELY(ss))
+        ss.append('{');
+    else
+        return suspend(
+            state::obj1, i, base, po);
+    if(BOOST_JSON_UNLIKELY(
+        i == n))
+        goto do_obj6;
+    for(;;)
+    {
+        kv = member(base, i);
+        cs0_ = {
+            kv->key().data(),
+            kv->key().size() };
+do_obj2:
+        if(BOOST_JSON_UNLIKELY(
+            ! write_string<StackEmpty>(ss)))
+            return suspend(
+                state::obj2, i, base, po);
+do_obj3:
+        if(BOOST_JSON_LIKELY(ss))
+            ss.append(':');
+        else
+            return suspend(
+                state::obj3, i, base, po);
+do_obj4:
+        jv_ = &member(base, i)->value();
+        if(BOOST_JSON_UNLIKELY(
+            ! write_value<StackEmpty>(ss)))
+            return suspend(
+                state::obj4, i, base, po);
+        ++i;
+        if(BOOST_JSON_UNLIKELY(i == n))
+            break;
+do_obj5:
+        if(BOOST_JSON_LIKELY(ss))
+            ss.append(',');
+        else
+            return suspend(
+                state::obj5, i, base, po);
+    }
+do_obj6:
+    if(BOOST_JSON_LIKELY(ss))
+    {
+        ss.append('}');
+        perm_.shrink(base *
+            sizeof(key_value_pair const*));
+        return true;
+    }
+    return suspend(
+        state::obj6, i, base, po);
+}
+
 template<bool StackEmpty>
 bool
 serializer::
@@ -616,6 +854,9 @@ write_value(stream& ss)
         default:
         case kind::object:
             po_ = &jv.get_object();
+            if(BOOST_JSON_UNLIKELY(
+                opts_.canonical))
+                return write_sorted<true>(ss);
             return write_object<true>(ss);
 
         case kind::array:
@@ -704,6 +945,9 @@ write_value(stream& ss)
         case state::obj1: case state::obj2:
         case state::obj3: case state::obj4:
         case state::obj5: case state::obj6:
+            if(BOOST_JSON_UNLIKELY(
+                opts_.canonical))
+                return write_sorted<StackEmpty>(ss);
             return write_object<StackEmpty>(ss);
         }
     }
@@ -744,6 +988,13 @@ serializer() noexcept
         sizeof(serializer::buf_) >= 7);
 }
 
+serializer::
+serializer(
+    serialize_options const& opts) noexcept
+    : opts_(opts)
+{
+}
+
 void
 serializer::
 reset(value const* p) noexcept
@@ -754,6 +1005,7 @@ reset(value const* p) noexcept
 
     jv_ = p;
     st_.clear();
+    perm_.clear();
     done_ = false;
 }
 
@@ -765,6 +1017,7 @@ reset(array const* p) noexcept
     fn0_ = &serializer::write_array<true>;
     fn1_ = &serializer::write_array<false>;
     st_.clear();
+    perm_.clear();
     done_ = false;
 }
 
@@ -773,9 +1026,18 @@ serializer::
 reset(object const* p) noexcept
 {
     po_ = p;
-    fn0_ = &serializer::write_object<true>;
-    fn1_ = &serializer::write_object<false>;
+    if(opts_.canonical)
+    {
+        fn0_ = &serializer::write_sorted<true>;
+        fn1_ = &serializer::write_sorted<false>;
+    }
+    else
+    {
+        fn0_ = &serializer::write_object<true>;
+        fn1_ = &serializer::write_object<false>;
+    }
     st_.clear();
+    perm_.clear();
     done_ = false;
 }
 
@@ -787,6 +1049,7 @@ reset(string const* p) noexcept
     fn0_ = &serializer::write_string<true>;
     fn1_ = &serializer::write_string<false>;
     st_.clear();
+    perm_.clear();
     done_ = false;
 }
 
@@ -798,6 +1061,7 @@ reset(string_view sv) noexcept
     fn0_ = &serializer::write_string<true>;
     fn1_ = &serializer::write_string<false>;
     st_.clear();
+    perm_.clear();
     done_ = false;
 }
 
@@ -805,12 +1069,15 @@ string_view
 serializer::
 read(char* dest, std::size_t size)
 {
+    BOOST_JSON_TRACE_SPAN(span, serialize, size);
     if(! jv_)
     {
         static value const null;
         jv_ = &null;
     }
-    return read_some(dest, size);
+    auto const s = read_some(dest, size);
+    BOOST_JSON_TRACE_RESULT(span, s.size());
+    return s;
 }
 
 BOOST_JSON_NS_END
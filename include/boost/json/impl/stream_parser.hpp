@@ -0,0 +1,60 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_STREAM_PARSER_HPP
+#define BOOST_JSON_IMPL_STREAM_PARSER_HPP
+
+#include <boost/json/detail/except.hpp>
+
+BOOST_JSON_NS_BEGIN
+
+template<class ConstBufferSequence, class>
+std::size_t
+stream_parser::
+write(
+    ConstBufferSequence const& buffers,
+    error_code& ec)
+{
+    gather_buffer g;
+    std::size_t n = 0;
+    for(auto const& b : buffers)
+    {
+        string_view const s =
+            detail::buffer_view(b);
+        if(s.size() <= g.capacity())
+        {
+            // fast path for small segments
+            g.append(s.data(), s.size());
+            continue;
+        }
+        n += write_gather(g, s, ec);
+        if(ec)
+            return n;
+    }
+    return n + write(
+        g.data(), g.size(), ec);
+}
+
+template<class ConstBufferSequence, class>
+std::size_t
+stream_parser::
+write(
+    ConstBufferSequence const& buffers)
+{
+    error_code ec;
+    auto const n = write(buffers, ec);
+    if(ec)
+        detail::throw_system_error(ec,
+            BOOST_JSON_SOURCE_POS);
+    return n;
+}
+
+BOOST_JSON_NS_END
+
+#endif
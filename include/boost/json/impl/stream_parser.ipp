@@ -12,6 +12,7 @@
 
 #include <boost/json/stream_parser.hpp>
 #include <boost/json/basic_parser_impl.hpp>
+#include <boost/json/detail/trace.hpp>
 #include <boost/json/error.hpp>
 #include <cstring>
 #include <stdexcept>
@@ -19,6 +20,36 @@
 
 BOOST_JSON_NS_BEGIN
 
+namespace detail {
+
+// Returns the offset one past the last character
+// in the buffer after which a new token begins,
+// or 0 if there is none. A split there does not
+// divide a literal, number or key in the parser.
+inline
+std::size_t
+last_token_break(
+    char const* p,
+    std::size_t n) noexcept
+{
+    while(n > 0)
+    {
+        switch(p[n - 1])
+        {
+        case ' ': case '\t': case '\r': case '\n':
+        case ',': case ':':
+        case '[': case ']': case '{': case '}':
+            return n;
+        default:
+            break;
+        }
+        --n;
+    }
+    return 0;
+}
+
+} // detail
+
 stream_parser::
 stream_parser(
     storage_ptr sp,
@@ -62,8 +93,11 @@ write_some(
     std::size_t size,
     error_code& ec)
 {
-    return p_.write_some(
+    BOOST_JSON_TRACE_SPAN(span, parse, size);
+    auto const n = p_.write_some(
         true, data, size, ec);
+    BOOST_JSON_TRACE_RESULT(span, n);
+    return n;
 }
 
 std::size_t
@@ -113,10 +147,54 @@ write(
     return n;
 }
 
+std::size_t
+stream_parser::
+write_gather(
+    gather_buffer& g,
+    string_view s,
+    error_code& ec)
+{
+    ec = {};
+    std::size_t n = 0;
+    while(s.size() > g.capacity())
+    {
+        if(! g.empty())
+        {
+            // fill the rest of the buffer up to
+            // the last token break, and parse it.
+            auto const k = detail::last_token_break(
+                s.data(), g.capacity());
+            g.append(s.data(), k);
+            s.remove_prefix(k);
+            n += write(g.data(), g.size(), ec);
+            g.clear();
+            if(ec)
+                return n;
+            continue;
+        }
+        // parse the segment in place, holding
+        // back the token which crosses its end.
+        auto const tail = s.size() - g.max_size();
+        auto k = detail::last_token_break(
+            s.data() + tail, g.max_size());
+        if(k > 0)
+            k += tail;
+        else
+            k = s.size();
+        n += write(s.data(), k, ec);
+        if(ec)
+            return n;
+        s.remove_prefix(k);
+    }
+    g.append(s.data(), s.size());
+    return n;
+}
+
 void
 stream_parser::
 finish(error_code& ec)
 {
+    BOOST_JSON_TRACE_SPAN(span, finish, 0);
     p_.write_some(false, nullptr, 0, ec);
 }
 
@@ -0,0 +1,51 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_TRACE_IPP
+#define BOOST_JSON_IMPL_TRACE_IPP
+
+#include <boost/json/trace.hpp>
+
+#ifdef BOOST_JSON_TRACE
+
+#include <atomic>
+
+BOOST_JSON_NS_BEGIN
+
+namespace detail {
+
+inline
+std::atomic<trace_hooks*>&
+trace_hooks_instance() noexcept
+{
+    static std::atomic<trace_hooks*> h{nullptr};
+    return h;
+}
+
+} // detail
+
+trace_hooks*
+set_trace_hooks(trace_hooks* h) noexcept
+{
+    return detail::trace_hooks_instance().exchange(
+        h, std::memory_order_acq_rel);
+}
+
+trace_hooks*
+get_trace_hooks() noexcept
+{
+    return detail::trace_hooks_instance().load(
+        std::memory_order_acquire);
+}
+
+BOOST_JSON_NS_END
+
+#endif
+
+#endif
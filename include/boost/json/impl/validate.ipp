@@ -0,0 +1,573 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_IMPL_VALIDATE_IPP
+#define BOOST_JSON_IMPL_VALIDATE_IPP
+
+#include <boost/json/validate.hpp>
+#include <boost/json/basic_parser_impl.hpp>
+#include <boost/json/detail/sse2.hpp>
+#include <boost/json/detail/utf8.hpp>
+#include <cstring>
+
+BOOST_JSON_NS_BEGIN
+namespace detail {
+
+// The deepest nesting which validate
+// accepts, whatever the options say.
+// One bit per level is kept on the stack.
+constexpr std::size_t validate_max_depth = 65536;
+
+// Checks a complete document against the same
+// grammar as basic_parser, but does not suspend,
+// convert numbers, unescape strings or call a
+// handler. Each function returns the position
+// following what it consumed, or null on error.
+template<
+    bool AllowComments,
+    bool AllowTrailing,
+    bool AllowBadUTF8>
+class validator
+{
+    char const* const end_;
+    char const* err_ = nullptr;
+    error ev_ = error::syntax;
+    std::size_t max_depth_;
+    std::size_t n_ = 0;
+    unsigned char kinds_[
+        validate_max_depth / 8];
+
+    char const*
+    fail(char const* p, error ev) noexcept
+    {
+        err_ = p;
+        ev_ = ev;
+        return nullptr;
+    }
+
+    // skip whitespace and comments
+    char const*
+    skip_ws(char const* p) noexcept
+    {
+        // most tokens are not preceded by whitespace
+        if(BOOST_JSON_LIKELY(p != end_) &&
+            static_cast<unsigned char>(*p) > ' ' &&
+            (! AllowComments || *p != '/'))
+            return p;
+        for(;;)
+        {
+            p = detail::count_whitespace(p, end_);
+            if(! AllowComments ||
+                p == end_ || *p != '/')
+                return p;
+            p = parse_comment(p);
+            if(BOOST_JSON_UNLIKELY(! p))
+                return nullptr;
+        }
+    }
+
+    // skip whitespace and comments,
+    // a token is required to follow
+    char const*
+    skip_to_token(char const* p) noexcept
+    {
+        p = skip_ws(p);
+        if(BOOST_JSON_UNLIKELY(p == end_))
+            return fail(p, error::incomplete);
+        return p;
+    }
+
+    char const*
+    parse_comment(char const* p) noexcept
+    {
+        BOOST_ASSERT(*p == '/');
+        ++p;
+        if(BOOST_JSON_UNLIKELY(p == end_))
+            return fail(p, error::incomplete);
+        if(*p == '/')
+        {
+            // a line comment may end the document
+            p = static_cast<char const*>(
+                std::memchr(p, '\n', end_ - p));
+            return p ? p + 1 : end_;
+        }
+        if(BOOST_JSON_UNLIKELY(*p != '*'))
+            return fail(p, error::syntax);
+        ++p;
+        for(;;)
+        {
+            p = static_cast<char const*>(
+                std::memchr(p, '*', end_ - p));
+            if(BOOST_JSON_UNLIKELY(! p))
+                return fail(end_, error::incomplete);
+            ++p;
+            if(BOOST_JSON_UNLIKELY(p == end_))
+                return fail(p, error::incomplete);
+            if(*p == '/')
+                return p + 1;
+        }
+    }
+
+    char const*
+    parse_literal(
+        char const* p,
+        char const* lit,
+        std::size_t n) noexcept
+    {
+        if(BOOST_JSON_LIKELY(
+            static_cast<std::size_t>(end_ - p) >= n &&
+            std::memcmp(p, lit, n) == 0))
+            return p + n;
+        // a mismatch is reported at the
+        // start of the literal, like basic_parser
+        for(char const* it = p;; ++it, ++lit)
+        {
+            if(it == end_)
+                return fail(it, error::incomplete);
+            if(*it != *lit)
+                return fail(p, error::syntax);
+        }
+    }
+
+    char const*
+    skip_digits(char const* p) noexcept
+    {
+        while(end_ - p >= 16)
+        {
+            int const n = detail::count_digits(p);
+            p += n;
+            if(n < 16)
+                return p;
+        }
+        while(p != end_ && static_cast<
+            unsigned char>(*p - '0') < 10)
+            ++p;
+        return p;
+    }
+
+    char const*
+    parse_number(char const* p) noexcept
+    {
+        if(*p == '-')
+        {
+            ++p;
+            if(BOOST_JSON_UNLIKELY(p == end_))
+                return fail(p, error::incomplete);
+        }
+        if(*p == '0')
+            ++p;
+        else if(BOOST_JSON_LIKELY(
+            *p >= '1' && *p <= '9'))
+            p = skip_digits(p + 1);
+        else
+            return fail(p, error::syntax);
+        if(p == end_)
+            return p;
+        if(*p == '.')
+        {
+            char const* const first = ++p;
+            p = skip_digits(p);
+            // digit required
+            if(BOOST_JSON_UNLIKELY(p == first))
+                return fail(p, p == end_ ?
+                    error::incomplete : error::syntax);
+            if(p == end_)
+                return p;
+        }
+        if((*p | 32) != 'e')
+            return p;
+        ++p;
+        if(BOOST_JSON_UNLIKELY(p == end_))
+            return fail(p, error::incomplete);
+        if(*p == '+' || *p == '-')
+        {
+            ++p;
+            if(BOOST_JSON_UNLIKELY(p == end_))
+                return fail(p, error::incomplete);
+        }
+        // digit required
+        if(BOOST_JSON_UNLIKELY(*p < '0' || *p > '9'))
+            return fail(p, error::syntax);
+        // the exponent must fit in an int,
+        // the same as for basic_parser
+        int exp = 0;
+        for(; p != end_ && *p >= '0' && *p <= '9'; ++p)
+        {
+            //        2147483647 INT_MAX
+            if(BOOST_JSON_UNLIKELY(
+                exp  > 214748364 || (
+                exp == 214748364 && *p > '7')))
+                return fail(p, error::exponent_overflow);
+            exp = 10 * exp + *p - '0';
+        }
+        return p;
+    }
+
+    char const*
+    parse_hex4(
+        char const* p,
+        unsigned& u) noexcept
+    {
+        if(BOOST_JSON_LIKELY(end_ - p >= 4))
+        {
+            u = detail::hex_digits4(p);
+            if(BOOST_JSON_LIKELY(u <= 0xffff))
+                return p + 4;
+        }
+        // find the offending digit
+        for(;; ++p)
+        {
+            if(p == end_)
+                return fail(p, error::incomplete);
+            if(detail::hex_digit(*p) == -1)
+                return fail(p, error::expected_hex_digit);
+        }
+    }
+
+    char const*
+    parse_escape(char const* p) noexcept
+    {
+        BOOST_ASSERT(*p == '\\');
+        ++p;
+        if(BOOST_JSON_UNLIKELY(p == end_))
+            return fail(p, error::incomplete);
+        switch(*p)
+        {
+        case '\x22': case '\\': case '/':
+        case 'b': case 'f': case 'n':
+        case 'r': case 't':
+            return p + 1;
+        case 'u':
+            break;
+        default:
+            return fail(p, error::syntax);
+        }
+        unsigned u1;
+        p = parse_hex4(p + 1, u1);
+        if(BOOST_JSON_UNLIKELY(! p))
+            return nullptr;
+        // valid unicode scalar values are
+        // [0, D7FF] and [E000, 10FFFF]
+        if(BOOST_JSON_LIKELY(
+            u1 < 0xd800 || u1 > 0xdfff))
+            return p;
+        if(BOOST_JSON_UNLIKELY(u1 > 0xdbff))
+            return fail(p - 5,
+                error::illegal_leading_surrogate);
+        if(BOOST_JSON_UNLIKELY(p == end_))
+            return fail(p, error::incomplete);
+        if(BOOST_JSON_UNLIKELY(*p != '\\'))
+            return fail(p, error::syntax);
+        ++p;
+        if(BOOST_JSON_UNLIKELY(p == end_))
+            return fail(p, error::incomplete);
+        if(BOOST_JSON_UNLIKELY(*p != 'u'))
+            return fail(p, error::syntax);
+        unsigned u2;
+        p = parse_hex4(p + 1, u2);
+        if(BOOST_JSON_UNLIKELY(! p))
+            return nullptr;
+        // valid trailing surrogates are [DC00, DFFF]
+        if(BOOST_JSON_UNLIKELY(
+            u2 < 0xdc00 || u2 > 0xdfff))
+            return fail(p - 4,
+                error::illegal_trailing_surrogate);
+        return p;
+    }
+
+    char const*
+    parse_string(char const* p) noexcept
+    {
+        BOOST_ASSERT(*p == '\x22'); // '"'
+        ++p;
+        for(;;)
+        {
+            p = detail::count_valid<
+                AllowBadUTF8>(p, end_);
+            if(BOOST_JSON_UNLIKELY(p == end_))
+                return fail(p, error::incomplete);
+            char const c = *p;
+            if(BOOST_JSON_LIKELY(c == '\x22'))
+                return p + 1;
+            if(c == '\\')
+            {
+                p = parse_escape(p);
+                if(BOOST_JSON_UNLIKELY(! p))
+                    return nullptr;
+                continue;
+            }
+            if(! AllowBadUTF8 && (c & 0x80))
+            {
+                // the sequence is invalid,
+                // or cut off by the end
+                std::size_t const n =
+                    detail::classify_utf8(c & 0x7F) & 0xFF;
+                if(static_cast<std::size_t>(end_ - p) < n)
+                    return fail(p, error::incomplete);
+            }
+            // illegal control or bad utf-8
+            return fail(p, error::syntax);
+        }
+    }
+
+    // push an open container, objects are set
+    void
+    push(bool is_object) noexcept
+    {
+        auto& b = kinds_[n_ / 8];
+        auto const mask = static_cast<
+            unsigned char>(1u << (n_ % 8));
+        if(is_object)
+            b |= mask;
+        else
+            b &= ~mask;
+        ++n_;
+    }
+
+    // return true if the innermost
+    // open container is an object
+    bool
+    top_is_object() const noexcept
+    {
+        BOOST_ASSERT(n_ > 0);
+        return (kinds_[(n_ - 1) / 8] >>
+            ((n_ - 1) % 8)) & 1;
+    }
+
+    // parse a key, the colon, and skip
+    // to the start of the member's value
+    char const*
+    parse_key(char const* p) noexcept
+    {
+        if(BOOST_JSON_UNLIKELY(*p != '\x22'))
+            return fail(p, error::syntax);
+        p = parse_string(p);
+        if(BOOST_JSON_UNLIKELY(! p))
+            return nullptr;
+        p = skip_to_token(p);
+        if(BOOST_JSON_UNLIKELY(! p))
+            return nullptr;
+        if(BOOST_JSON_UNLIKELY(*p != ':'))
+            return fail(p, error::syntax);
+        return skip_to_token(p + 1);
+    }
+
+    char const*
+    parse_scalar(char const* p) noexcept
+    {
+        BOOST_ASSERT(p != end_);
+        switch(*p)
+        {
+        case '\x22':
+            return parse_string(p);
+        case 't':
+            return parse_literal(p, "true", 4);
+        case 'f':
+            return parse_literal(p, "false", 5);
+        case 'n':
+            return parse_literal(p, "null", 4);
+        case '-':
+        case '0': case '1': case '2':
+        case '3': case '4': case '5':
+        case '6': case '7': case '8':
+        case '9':
+            return parse_number(p);
+        default:
+            return fail(p, error::syntax);
+        }
+    }
+
+    // Containers are tracked in kinds_ rather
+    // than by recursion, so hostile nesting
+    // cannot overflow the call stack.
+    char const*
+    parse_value(char const* p) noexcept
+    {
+        for(;;)
+        {
+            // p is at the start of a value
+            BOOST_ASSERT(p != end_);
+            char const c = *p;
+            if(c == '[' || c == '{')
+            {
+                if(BOOST_JSON_UNLIKELY(
+                        n_ == max_depth_))
+                    return fail(p, error::too_deep);
+                push(c == '{');
+                p = skip_to_token(p + 1);
+                if(BOOST_JSON_UNLIKELY(! p))
+                    return nullptr;
+                if(*p != (c == '[' ? ']' : '}'))
+                {
+                    if(c == '{')
+                    {
+                        p = parse_key(p);
+                        if(BOOST_JSON_UNLIKELY(! p))
+                            return nullptr;
+                    }
+                    continue;
+                }
+                // empty container
+                ++p;
+                --n_;
+            }
+            else
+            {
+                p = parse_scalar(p);
+                if(BOOST_JSON_UNLIKELY(! p))
+                    return nullptr;
+            }
+
+            // p follows a complete value,
+            // close containers until the
+            // next value starts
+            for(;;)
+            {
+                if(n_ == 0)
+                    return p;
+                p = skip_to_token(p);
+                if(BOOST_JSON_UNLIKELY(! p))
+                    return nullptr;
+                bool const is_object =
+                    top_is_object();
+                char const close =
+                    is_object ? '}' : ']';
+                if(*p == close)
+                {
+                    ++p;
+                    --n_;
+                    continue;
+                }
+                if(BOOST_JSON_UNLIKELY(*p != ','))
+                    return fail(p, error::syntax);
+                p = skip_to_token(p + 1);
+                if(BOOST_JSON_UNLIKELY(! p))
+                    return nullptr;
+                if(AllowTrailing && *p == close)
+                {
+                    ++p;
+                    --n_;
+                    continue;
+                }
+                if(is_object)
+                {
+                    p = parse_key(p);
+                    if(BOOST_JSON_UNLIKELY(! p))
+                        return nullptr;
+                }
+                break;
+            }
+        }
+    }
+
+public:
+    validator(
+        char const* end,
+        std::size_t max_depth) noexcept
+        : end_(end)
+        , max_depth_(max_depth < validate_max_depth ?
+            max_depth : validate_max_depth)
+    {
+    }
+
+    std::size_t
+    validate(
+        char const* begin,
+        error_code& ec) noexcept
+    {
+        char const* p = skip_to_token(begin);
+        if(BOOST_JSON_LIKELY(p))
+            p = parse_value(p);
+        if(BOOST_JSON_LIKELY(p))
+            p = skip_ws(p);
+        if(BOOST_JSON_LIKELY(p))
+        {
+            if(BOOST_JSON_LIKELY(p == end_))
+            {
+                ec = {};
+                return p - begin;
+            }
+            fail(p, error::extra_data);
+        }
+        ec = ev_;
+        return err_ - begin;
+    }
+};
+
+template<
+    bool AllowComments,
+    bool AllowTrailing,
+    bool AllowBadUTF8>
+std::size_t
+validate_impl(
+    string_view s,
+    error_code& ec,
+    parse_options const& opt) noexcept
+{
+    validator<
+        AllowComments,
+        AllowTrailing,
+        AllowBadUTF8> v(
+            s.data() + s.size(),
+            opt.max_depth);
+    return v.validate(s.data(), ec);
+}
+
+} // detail
+
+std::size_t
+validate(
+    string_view s,
+    error_code& ec,
+    parse_options const& opt) noexcept
+{
+    switch(+opt.allow_comments |
+        (opt.allow_trailing_commas << 1) |
+        (opt.allow_invalid_utf8 << 2))
+    {
+    // no extensions
+    default:
+        return detail::validate_impl<false, false, false>(s, ec, opt);
+    // comments
+    case 1:
+        return detail::validate_impl<true, false, false>(s, ec, opt);
+    // trailing
+    case 2:
+        return detail::validate_impl<false, true, false>(s, ec, opt);
+    // comments & trailing
+    case 3:
+        return detail::validate_impl<true, true, false>(s, ec, opt);
+    // skip validation
+    case 4:
+        return detail::validate_impl<false, false, true>(s, ec, opt);
+    // comments & skip validation
+    case 5:
+        return detail::validate_impl<true, false, true>(s, ec, opt);
+    // trailing & skip validation
+    case 6:
+        return detail::validate_impl<false, true, true>(s, ec, opt);
+    // comments & trailing & skip validation
+    case 7:
+        return detail::validate_impl<true, true, true>(s, ec, opt);
+    }
+}
+
+bool
+validate(
+    string_view s,
+    parse_options const& opt) noexcept
+{
+    error_code ec;
+    validate(s, ec, opt);
+    return ! ec;
+}
+
+BOOST_JSON_NS_END
+
+#endif
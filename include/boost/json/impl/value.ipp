@@ -11,6 +11,7 @@
 #define BOOST_JSON_IMPL_VALUE_IPP
 
 #include <boost/json/value.hpp>
+#include <boost/json/detail/digest.hpp>
 #include <cstring>
 #include <limits>
 #include <new>
@@ -451,6 +452,105 @@ equal(value const& other) const noexcept
     }
 }
 
+//----------------------------------------------------------
+//
+// hashing
+//
+//----------------------------------------------------------
+
+namespace detail {
+
+// Values which compare equal must have equal
+// digests, so the integers are hashed alike
+// regardless of kind, and zero has one sign.
+
+std::size_t
+digest(value const& jv) noexcept
+{
+    // mixing the kind into each digest keeps
+    // null, false, 0 and empty containers apart
+    auto const tag = [](json::kind k)
+    {
+        return static_cast<std::size_t>(k) + 1;
+    };
+    switch(jv.kind())
+    {
+    default: // unreachable()?
+    case json::kind::null:
+    case json::kind::bool_:
+        return salt_digest(
+            jv.is_bool() && jv.get_bool(),
+            tag(jv.kind()));
+
+    case json::kind::int64:
+        return salt_digest(
+            static_cast<std::size_t>(
+                jv.get_int64()),
+            tag(json::kind::int64));
+
+    case json::kind::uint64:
+        return salt_digest(
+            static_cast<std::size_t>(
+                jv.get_uint64()),
+            tag(json::kind::int64));
+
+    case json::kind::double_:
+    {
+        auto d = jv.get_double();
+        if(d == 0)
+            d = 0;
+        std::uint64_t bits;
+        std::memcpy(&bits, &d, sizeof(d));
+        return salt_digest(
+            static_cast<std::size_t>(
+                bits ^ (bits >> 32)),
+            tag(json::kind::double_));
+    }
+
+    case json::kind::string:
+    {
+        auto const& js = jv.get_string();
+        return salt_digest(
+            digest(js.data(), js.size()),
+            tag(json::kind::string));
+    }
+
+    case json::kind::array:
+        return digest(jv.get_array());
+
+    case json::kind::object:
+        return digest(jv.get_object());
+    }
+}
+
+std::size_t
+digest(array const& arr) noexcept
+{
+    // order-sensitive
+    std::size_t h = arr.size();
+    for(auto const& jv : arr)
+        h = salt_digest(h, digest(jv));
+    return salt_digest(h, static_cast<
+        std::size_t>(json::kind::array) + 1);
+}
+
+std::size_t
+digest(object const& obj) noexcept
+{
+    // order-insensitive, because objects
+    // with the same members in a different
+    // order compare equal
+    std::size_t h = obj.size();
+    for(auto const& kv : obj)
+        h += salt_digest(
+            digest(kv.key().data(), kv.key().size()),
+            digest(kv.value()));
+    return salt_digest(h, static_cast<
+        std::size_t>(json::kind::object) + 1);
+}
+
+} // detail
+
 //----------------------------------------------------------
 //
 // key_value_pair
@@ -11,6 +11,7 @@
 #define BOOST_JSON_IMPL_VALUE_STACK_IPP
 
 #include <boost/json/value_stack.hpp>
+#include <boost/json/detail/trace.hpp>
 #include <cstring>
 #include <stdexcept>
 #include <utility>
@@ -356,6 +357,8 @@ void
 value_stack::
 push_array(std::size_t n)
 {
+    BOOST_JSON_TRACE_SPAN(span, build_array, n);
+    BOOST_JSON_TRACE_RESULT(span, n);
     // we already have room if n > 0
     if(BOOST_JSON_UNLIKELY(n == 0))
         st_.maybe_grow();
@@ -368,6 +371,8 @@ void
 value_stack::
 push_object(std::size_t n)
 {
+    BOOST_JSON_TRACE_SPAN(span, build_object, n);
+    BOOST_JSON_TRACE_RESULT(span, n);
     // we already have room if n > 0
     if(BOOST_JSON_UNLIKELY(n == 0))
         st_.maybe_grow();
@@ -0,0 +1,346 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_JSON_PATH_HPP
+#define BOOST_JSON_JSON_PATH_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/error.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/string_view.hpp>
+#include <boost/json/value.hpp>
+#include <cstddef>
+#include <cstdint>
+
+BOOST_JSON_NS_BEGIN
+
+namespace detail {
+struct path_handler;
+} // detail
+
+/** A compiled JSONPath expression
+
+    This container holds a JSONPath expression, parsed
+    once into a sequence of segments which are evaluated
+    as a finite automaton. The automaton can be run over
+    an existing @ref value using @ref select, or over the
+    events of a parser using @ref path_parser, which finds
+    matches without building the rest of the document.
+\n
+    The supported subset of JSONPath is:
+
+    @li `$` The root, which must begin every expression.
+
+    @li `.name` or `['name']` A member of an object.
+        Quoted names may use single or double quotes,
+        and a backslash escapes the quote or a backslash.
+
+    @li `.*` or `[*]` Every element of an object or array.
+
+    @li `[n]` The element of an array at index `n`.
+
+    @li `[start:end:step]` The elements of an array from
+        `start`, inclusive, to `end`, exclusive, every
+        `step` elements. Each part is optional, and they
+        default to the beginning, the end, and one.
+
+    @li `..` followed by any of the above applies it to
+        every descendant instead of only to children.
+
+    Negative indexes and steps, filter expressions and
+    unions are not supported. An expression may have
+    at most 63 segments.
+
+    @par Example
+
+    @code
+
+    json_path const jp( "$.users[*].name" );
+
+    value jv = parse( R"({"users":[{"name":"Alice"},{"name":"Bob"}]})" );
+
+    array names = jp.select( jv ); // ["Alice","Bob"]
+
+    @endcode
+
+    @par Thread Safety
+    Distinct instances may be accessed concurrently.
+    Non-const member functions of a shared instance
+    may not be called concurrently with any other
+    member functions of that instance.
+
+    @see
+        @ref path_parser,
+        https://goessner.net/articles/JsonPath/
+*/
+class json_path
+{
+    friend struct detail::path_handler;
+
+    struct segment;
+
+    storage_ptr sp_;            // must come first
+    segment* s_ = nullptr;      // segments, then names
+    std::size_t n_ = 0;         // number of segments
+    std::size_t bytes_ = 0;     // size of allocation
+
+public:
+    /// The maximum number of segments in an expression
+    static constexpr std::size_t max_size = 63;
+
+    /** Destructor
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    BOOST_JSON_DECL
+    ~json_path();
+
+    /** Constructor
+
+        The constructed expression is `$`,
+        which matches the whole document.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    json_path() = default;
+
+    /** Constructor
+
+        This parses the string `s` as a JSONPath expression.
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param s The string to parse.
+
+        @param sp The memory resource to use for the
+        segments. If this parameter is omitted, the
+        default memory resource is used.
+
+        @throw system_error on a syntax error, or if
+        the expression has too many segments.
+    */
+    BOOST_JSON_DECL
+    explicit
+    json_path(
+        string_view s,
+        storage_ptr sp = {});
+
+    /** Constructor
+
+        This parses the string `s` as a JSONPath expression.
+        If an error occurs, `ec` is set and the constructed
+        expression is `$`. The error is @ref error::syntax
+        for a malformed or unsupported expression, and
+        @ref error::too_deep if the expression has more
+        than @ref max_size segments.
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param s The string to parse.
+
+        @param ec Set to the error, if any occurred.
+
+        @param sp The memory resource to use for the
+        segments. If this parameter is omitted, the
+        default memory resource is used.
+    */
+    BOOST_JSON_DECL
+    json_path(
+        string_view s,
+        error_code& ec,
+        storage_ptr sp = {});
+
+    /** Copy constructor
+
+        @par Complexity
+        Linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The expression to copy.
+    */
+    BOOST_JSON_DECL
+    json_path(json_path const& other);
+
+    /** Move constructor
+
+        Ownership of the segments is transferred, and
+        `other` is left as `$` with the same memory
+        resource.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param other The expression to move.
+    */
+    BOOST_JSON_DECL
+    json_path(json_path&& other) noexcept;
+
+    /** Copy assignment
+
+        @par Complexity
+        Linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The expression to copy.
+    */
+    BOOST_JSON_DECL
+    json_path&
+    operator=(json_path const& other);
+
+    /** Move assignment
+
+        @par Complexity
+        Constant if the memory resources compare
+        equal, otherwise linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The expression to move.
+    */
+    BOOST_JSON_DECL
+    json_path&
+    operator=(json_path&& other);
+
+    /** Return the associated memory resource
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    storage_ptr const&
+    storage() const noexcept
+    {
+        return sp_;
+    }
+
+    /** Return the number of segments
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return copies of the values matched in a document
+
+        The matches are returned in document order,
+        with a value preceding the matches nested
+        within it.
+
+        @par Complexity
+        Linear in the size of `jv`, plus the size
+        of the matches.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param jv The document to search.
+
+        @param sp The memory resource to use for the
+        returned array and its elements. If this
+        parameter is omitted, the default memory
+        resource is used.
+    */
+    BOOST_JSON_DECL
+    array
+    select(
+        value const& jv,
+        storage_ptr sp = {}) const;
+
+private:
+    using mask_type = std::uint64_t;
+
+    // bit `i` of a mask means that the first `i`
+    // segments have been matched, a value whose
+    // mask has bit `size()` set is a match.
+    mask_type
+    start() const noexcept
+    {
+        return 1;
+    }
+
+    mask_type
+    accept() const noexcept
+    {
+        return mask_type(1) << n_;
+    }
+
+    BOOST_JSON_DECL
+    mask_type
+    step(
+        mask_type m,
+        string_view key) const noexcept;
+
+    BOOST_JSON_DECL
+    mask_type
+    step(
+        mask_type m,
+        std::size_t index) const noexcept;
+
+    BOOST_JSON_DECL
+    void
+    select_impl(
+        value const& jv,
+        mask_type m,
+        array& out) const;
+
+    void
+    parse(
+        string_view s,
+        error_code& ec);
+
+    void
+    release() noexcept;
+
+    char const*
+    text() const noexcept;
+};
+
+BOOST_JSON_NS_END
+
+#endif
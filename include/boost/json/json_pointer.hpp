@@ -0,0 +1,420 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_JSON_POINTER_HPP
+#define BOOST_JSON_JSON_POINTER_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/error.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/string_view.hpp>
+#include <boost/json/value.hpp>
+#include <cstddef>
+
+BOOST_JSON_NS_BEGIN
+
+/** A compiled JSON Pointer
+
+    This container holds a JSON Pointer as defined in
+    <a href="https://tools.ietf.org/html/rfc6901">RFC 6901</a>,
+    parsed once into its sequence of reference tokens.
+    Escape sequences are decoded and tokens which
+    are array indexes are converted to integers, all
+    when the pointer is constructed. Evaluating the
+    pointer against a @ref value therefore does no
+    parsing, and a pointer which is used many times
+    pays for this work only once. Keys are hashed
+    during lookup with the salt of each object, so
+    a pointer does not weaken the protection of
+    randomized hash tables.
+\n
+    In addition to lookup, the function @ref emplace
+    resolves the pointer while creating any values
+    which are missing along the way.
+
+    @par Example
+
+    @code
+
+    json_pointer const ptr( "/users/0/name" );
+
+    value jv = parse( R"({"users":[{"name":"Alice"}]})" );
+
+    assert( ptr.at( jv ) == "Alice" );
+
+    @endcode
+
+    @par Thread Safety
+    Distinct instances may be accessed concurrently.
+    Non-const member functions of a shared instance
+    may not be called concurrently with any other
+    member functions of that instance.
+
+    @see
+        https://tools.ietf.org/html/rfc6901
+*/
+class json_pointer
+{
+    struct token;
+
+    storage_ptr sp_;            // must come first
+    token* t_ = nullptr;        // tokens, then decoded text
+    std::size_t n_ = 0;         // number of tokens
+    std::size_t bytes_ = 0;     // size of allocation
+
+public:
+    /** Destructor
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    BOOST_JSON_DECL
+    ~json_pointer();
+
+    /** Constructor
+
+        The constructed pointer has no reference tokens,
+        and refers to the whole document.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    json_pointer() = default;
+
+    /** Constructor
+
+        This parses the string `s` as a JSON Pointer.
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param s The string to parse.
+
+        @param sp The memory resource to use for the
+        tokens. If this parameter is omitted, the default
+        memory resource is used.
+
+        @throw system_error on a syntax error.
+    */
+    BOOST_JSON_DECL
+    explicit
+    json_pointer(
+        string_view s,
+        storage_ptr sp = {});
+
+    /** Constructor
+
+        This parses the string `s` as a JSON Pointer.
+        If a syntax error occurs, `ec` is set and the
+        constructed pointer is empty.
+
+        @par Complexity
+        Linear in `s.size()`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param s The string to parse.
+
+        @param ec Set to the error, if any occurred.
+
+        @param sp The memory resource to use for the
+        tokens. If this parameter is omitted, the default
+        memory resource is used.
+    */
+    BOOST_JSON_DECL
+    json_pointer(
+        string_view s,
+        error_code& ec,
+        storage_ptr sp = {});
+
+    /** Copy constructor
+
+        @par Complexity
+        Linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The pointer to copy.
+    */
+    BOOST_JSON_DECL
+    json_pointer(json_pointer const& other);
+
+    /** Move constructor
+
+        Ownership of the tokens is transferred, and
+        `other` is left empty with the same memory
+        resource.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param other The pointer to move.
+    */
+    BOOST_JSON_DECL
+    json_pointer(json_pointer&& other) noexcept;
+
+    /** Copy assignment
+
+        @par Complexity
+        Linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The pointer to copy.
+    */
+    BOOST_JSON_DECL
+    json_pointer&
+    operator=(json_pointer const& other);
+
+    /** Move assignment
+
+        @par Complexity
+        Constant if the memory resources compare
+        equal, otherwise linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The pointer to move.
+    */
+    BOOST_JSON_DECL
+    json_pointer&
+    operator=(json_pointer&& other);
+
+    /** Return the associated memory resource
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    storage_ptr const&
+    storage() const noexcept
+    {
+        return sp_;
+    }
+
+    /** Return the number of reference tokens
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    std::size_t
+    size() const noexcept
+    {
+        return n_;
+    }
+
+    /** Return `true` if there are no reference tokens
+
+        An empty pointer refers to the whole document.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    bool
+    empty() const noexcept
+    {
+        return n_ == 0;
+    }
+
+    /** Return a decoded reference token
+
+        @par Precondition
+        `pos < size()`
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param pos A zero-based index.
+    */
+    BOOST_JSON_DECL
+    string_view
+    operator[](std::size_t pos) const noexcept;
+
+    /** Return a pointer to the referenced value, or `nullptr`
+
+        If the value referred to by this pointer exists
+        within `jv`, a pointer to it is returned.
+        Otherwise, `ec` is set to the reason and `nullptr`
+        is returned.
+
+        @par Complexity
+        Linear in `size()`, plus the cost of each
+        object lookup.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param jv The value to search.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    value const*
+    find(
+        value const& jv,
+        error_code& ec) const noexcept;
+
+    value*
+    find(
+        value& jv,
+        error_code& ec) const noexcept
+    {
+        return const_cast<value*>(find(
+            static_cast<value const&>(jv), ec));
+    }
+
+    value const*
+    find(value const& jv) const noexcept
+    {
+        error_code ec;
+        return find(jv, ec);
+    }
+
+    value*
+    find(value& jv) const noexcept
+    {
+        error_code ec;
+        return find(jv, ec);
+    }
+    /** @} */
+
+    /** Return a reference to the referenced value
+
+        @par Complexity
+        Linear in `size()`, plus the cost of each
+        object lookup.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @param jv The value to search.
+
+        @throw system_error if the value does not exist.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    value const&
+    at(value const& jv) const;
+
+    value&
+    at(value& jv) const
+    {
+        return const_cast<value&>(
+            at(static_cast<value const&>(jv)));
+    }
+    /** @} */
+
+    /** Return the referenced value, creating it if missing
+
+        The pointer is resolved against `jv`. Along the
+        way, a null value is replaced with an empty array
+        if the next token is an array index or `"-"`, and
+        with an empty object otherwise. A key which is
+        missing from an object is inserted with a null
+        value. An array index equal to the size of the
+        array, or the token `"-"`, appends a null value.
+        If the referenced value is created, it is null.
+
+        @par Complexity
+        Linear in `size()`, plus the cost of each
+        object lookup and insertion.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @return A pointer to the referenced value, or
+        `nullptr` if it could not be created.
+
+        @param jv The value to modify.
+
+        @param ec Set to the error, if any occurred.
+        Errors occur when a token is applied to a
+        value which is not null, an object or an array,
+        when a token applied to an array is not an index,
+        or when an array index is greater than the size
+        of the array.
+    */
+    BOOST_JSON_DECL
+    value*
+    emplace(
+        value& jv,
+        error_code& ec) const;
+
+    /** Return the referenced value, creating it if missing
+
+        This function behaves as the overload taking
+        an error code, except that errors are reported
+        by throwing an exception.
+
+        @par Complexity
+        Linear in `size()`, plus the cost of each
+        object lookup and insertion.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param jv The value to modify.
+
+        @throw system_error if the value cannot be created.
+    */
+    BOOST_JSON_DECL
+    value&
+    emplace(value& jv) const;
+
+private:
+    void
+    parse(
+        string_view s,
+        error_code& ec);
+
+    void
+    release() noexcept;
+
+    char const*
+    text() const noexcept;
+};
+
+BOOST_JSON_NS_END
+
+#endif
@@ -0,0 +1,510 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_JSON_SCHEMA_HPP
+#define BOOST_JSON_JSON_SCHEMA_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/error.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/string_view.hpp>
+#include <boost/json/value.hpp>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+BOOST_JSON_NS_BEGIN
+
+namespace detail {
+struct schema_handler;
+} // detail
+
+/** A compiled JSON Schema
+
+    This container holds a JSON Schema, compiled once
+    into a table of nodes which can be checked against
+    a value. The schema can be applied to an existing
+    @ref value using @ref validate, or to the events of
+    a parser using @ref schema_parser, which rejects
+    invalid input as soon as the first violation is
+    seen, in the same pass that builds the value.
+\n
+    The supported subset of JSON Schema is:
+
+    @li `true` and `false`, which accept every value
+        and no value respectively.
+
+    @li `type`, as a string or an array of strings
+        naming the allowed types. A number with no
+        fractional part is an `"integer"`.
+
+    @li `properties`, `required` and
+        `additionalProperties` for objects. A schema
+        may list at most 64 required properties.
+
+    @li `items`, as a single schema for every element.
+
+    @li `minimum`, `maximum`, `exclusiveMinimum` and
+        `exclusiveMaximum`, as numbers.
+
+    @li `minLength` and `maxLength`, counted in code points,
+        `minItems`, `maxItems`, `minProperties` and
+        `maxProperties`.
+
+    The annotations `$schema`, `$id`, `$comment`, `title`,
+    `description`, `default` and `examples` are ignored.
+    Any other keyword is rejected when the schema is
+    compiled, so a schema is never silently weakened.
+
+    @par Example
+
+    @code
+
+    json_schema const schema( parse( R"({
+        "type": "object",
+        "required": ["id"],
+        "properties": {
+            "id": { "type": "integer", "minimum": 1 },
+            "name": { "type": "string", "maxLength": 64 }
+        }
+    })" ) );
+
+    error_code ec;
+    schema.validate( parse( R"({"id":0})" ), ec ); // ec == error::out_of_range
+
+    @endcode
+
+    @par Thread Safety
+    Distinct instances may be accessed concurrently.
+    Non-const member functions of a shared instance
+    may not be called concurrently with any other
+    member functions of that instance.
+
+    @see
+        @ref schema_parser,
+        https://json-schema.org/draft/2020-12/json-schema-validation.html
+*/
+class json_schema
+{
+    friend struct detail::schema_handler;
+
+    // type bits
+    static constexpr unsigned null_type = 1;
+    static constexpr unsigned boolean_type = 2;
+    static constexpr unsigned integer_type = 4;
+    static constexpr unsigned fraction_type = 8;
+    static constexpr unsigned string_type = 16;
+    static constexpr unsigned array_type = 32;
+    static constexpr unsigned object_type = 64;
+    static constexpr unsigned all_types = 127;
+
+    // index of an unconstrained schema
+    static constexpr std::size_t any =
+        std::size_t(-1);
+
+    struct bound
+    {
+        kind k;
+        union
+        {
+            std::int64_t i;
+            std::uint64_t u;
+            double d;
+        };
+
+        inline
+        int
+        compare(bound const& other) const noexcept;
+    };
+
+    struct node
+    {
+        std::size_t props;      // first property
+        std::size_t nprops;
+        std::size_t nrequired;
+        std::size_t items;
+        std::size_t additional;
+        std::size_t min_length;
+        std::size_t max_length;
+        std::size_t min_items;
+        std::size_t max_items;
+        std::size_t min_props;
+        std::size_t max_props;
+        bound minimum;
+        bound maximum;
+        unsigned types;
+        bool has_minimum;
+        bool has_maximum;
+        bool exclusive_minimum;
+        bool exclusive_maximum;
+
+        inline
+        bool
+        check_number(
+            bound const& b,
+            error_code& ec) const noexcept;
+    };
+
+    struct property
+    {
+        std::size_t hash;
+        std::size_t offset;     // name, from start of allocation
+        std::size_t size;
+        std::size_t schema;
+        std::size_t bit;        // of a required property, or `any`
+    };
+
+    class compiler;
+
+    storage_ptr sp_;            // must come first
+    node* n_ = nullptr;         // nodes, properties, then names
+    std::size_t size_ = 0;      // number of nodes
+    std::size_t bytes_ = 0;     // size of allocation
+
+public:
+    /** Destructor
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    BOOST_JSON_DECL
+    ~json_schema();
+
+    /** Constructor
+
+        The constructed schema is `true`,
+        which accepts every value.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    json_schema() = default;
+
+    /** Constructor
+
+        This compiles the value `schema`.
+
+        @par Complexity
+        Linear in the size of `schema`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param schema The schema to compile.
+
+        @param sp The memory resource to use for the
+        compiled schema. If this parameter is omitted,
+        the default memory resource is used.
+
+        @throw system_error if `schema` is malformed or
+        uses an unsupported keyword.
+    */
+    BOOST_JSON_DECL
+    explicit
+    json_schema(
+        value const& schema,
+        storage_ptr sp = {});
+
+    /** Constructor
+
+        This compiles the value `schema`. If an error
+        occurs, `ec` is set to @ref error::invalid_schema
+        and the constructed schema is `true`.
+
+        @par Complexity
+        Linear in the size of `schema`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param schema The schema to compile.
+
+        @param ec Set to the error, if any occurred.
+
+        @param sp The memory resource to use for the
+        compiled schema. If this parameter is omitted,
+        the default memory resource is used.
+    */
+    BOOST_JSON_DECL
+    json_schema(
+        value const& schema,
+        error_code& ec,
+        storage_ptr sp = {});
+
+    /** Copy constructor
+
+        @par Complexity
+        Linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The schema to copy.
+    */
+    BOOST_JSON_DECL
+    json_schema(json_schema const& other);
+
+    /** Move constructor
+
+        Ownership of the nodes is transferred, and
+        `other` is left as `true` with the same memory
+        resource.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param other The schema to move.
+    */
+    BOOST_JSON_DECL
+    json_schema(json_schema&& other) noexcept;
+
+    /** Copy assignment
+
+        @par Complexity
+        Linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The schema to copy.
+    */
+    BOOST_JSON_DECL
+    json_schema&
+    operator=(json_schema const& other);
+
+    /** Move assignment
+
+        @par Complexity
+        Constant if the memory resources compare
+        equal, otherwise linear in the size of `other`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param other The schema to move.
+    */
+    BOOST_JSON_DECL
+    json_schema&
+    operator=(json_schema&& other);
+
+    /** Return the associated memory resource
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    storage_ptr const&
+    storage() const noexcept
+    {
+        return sp_;
+    }
+
+    /** Check a value against the schema
+
+        This function checks `jv` against the schema.
+        If the value is not valid, `ec` is set to the
+        first violation found, in document order. The
+        possible errors are @ref error::type_mismatch,
+        @ref error::required_missing,
+        @ref error::additional_property,
+        @ref error::out_of_range and
+        @ref error::size_out_of_range.
+
+        @par Complexity
+        Linear in the size of `jv`.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param jv The value to check.
+
+        @param ec Set to the error, if any occurred.
+    */
+    BOOST_JSON_DECL
+    void
+    validate(
+        value const& jv,
+        error_code& ec) const noexcept;
+
+    /** Check a value against the schema
+
+        This function checks `jv` against the schema.
+
+        @par Complexity
+        Linear in the size of `jv`.
+
+        @par Exception Safety
+        Strong guarantee.
+
+        @param jv The value to check.
+
+        @throw system_error if the value is not valid.
+    */
+    BOOST_JSON_DECL
+    void
+    validate(value const& jv) const;
+
+private:
+    std::size_t
+    root() const noexcept
+    {
+        return size_ ? 0 : any;
+    }
+
+    node const&
+    at(std::size_t i) const noexcept
+    {
+        return n_[i];
+    }
+
+    property const&
+    prop(std::size_t i) const noexcept
+    {
+        return reinterpret_cast<
+            property const*>(n_ + size_)[i];
+    }
+
+    bool
+    rejects(std::size_t i) const noexcept
+    {
+        return i != any && n_[i].types == 0;
+    }
+
+    static
+    std::size_t
+    code_points(string_view s) noexcept
+    {
+        std::size_t n = 0;
+        for(unsigned char c : s)
+            n += (c & 0xC0) != 0x80;
+        return n;
+    }
+
+    BOOST_JSON_DECL
+    property const*
+    find(
+        node const& nd,
+        string_view key) const noexcept;
+
+    bool
+    check(
+        std::size_t i,
+        value const& jv,
+        error_code& ec) const noexcept;
+
+    void
+    compile(
+        value const& schema,
+        error_code& ec);
+
+    void
+    release() noexcept;
+
+    char const*
+    text() const noexcept
+    {
+        return reinterpret_cast<
+            char const*>(n_);
+    }
+};
+
+//----------------------------------------------------------
+
+int
+json_schema::
+bound::
+compare(bound const& other) const noexcept
+{
+    auto const as_double = [](bound const& b)
+    {
+        if(b.k == kind::int64)
+            return static_cast<double>(b.i);
+        if(b.k == kind::uint64)
+            return static_cast<double>(b.u);
+        return b.d;
+    };
+    if( k == kind::double_ ||
+        other.k == kind::double_)
+    {
+        double const x = as_double(*this);
+        double const y = as_double(other);
+        return (x > y) - (x < y);
+    }
+    if(k == other.k)
+    {
+        if(k == kind::int64)
+            return (i > other.i) - (i < other.i);
+        return (u > other.u) - (u < other.u);
+    }
+    if(k == kind::int64)
+    {
+        if(i < 0)
+            return -1;
+        auto const x = static_cast<std::uint64_t>(i);
+        return (x > other.u) - (x < other.u);
+    }
+    return -other.compare(*this);
+}
+
+bool
+json_schema::
+node::
+check_number(
+    bound const& b,
+    error_code& ec) const noexcept
+{
+    unsigned const t =
+        b.k != kind::double_ ||
+        std::floor(b.d) == b.d ?
+        integer_type : fraction_type;
+    if(! (types & t))
+    {
+        ec = error::type_mismatch;
+        return false;
+    }
+    if(has_minimum)
+    {
+        int const c = b.compare(minimum);
+        if(c < 0 || (c == 0 && exclusive_minimum))
+        {
+            ec = error::out_of_range;
+            return false;
+        }
+    }
+    if(has_maximum)
+    {
+        int const c = b.compare(maximum);
+        if(c > 0 || (c == 0 && exclusive_maximum))
+        {
+            ec = error::out_of_range;
+            return false;
+        }
+    }
+    return true;
+}
+
+BOOST_JSON_NS_END
+
+#endif
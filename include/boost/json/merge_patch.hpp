@@ -0,0 +1,112 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_MERGE_PATCH_HPP
+#define BOOST_JSON_MERGE_PATCH_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/value.hpp>
+
+BOOST_JSON_NS_BEGIN
+
+/** Apply a JSON Merge Patch to a value in place.
+
+    This function modifies `target` as described
+    by the merge patch `patch`, following the
+    algorithm of RFC 7386:
+
+    @li If `patch` is not an object, `target`
+    is replaced by `patch`.
+
+    @li Otherwise `target` is made an object if it
+    is not one, and for each member of `patch`, a
+    null value removes the member with the same key
+    from `target`, and any other value is merged
+    into the member with the same key, which is
+    added if it does not exist.
+
+    Only the members named in the patch are
+    visited. Members are removed without
+    reallocating the object, and the order of
+    the remaining members may change.
+    Values are created using the memory resource
+    of `target`.
+
+    @par Example
+    @code
+    value jv = parse( R"({"a":"b","c":{"d":"e","f":"g"}})" );
+
+    merge_patch( jv, parse( R"({"a":"z","c":{"f":null}})" ) );
+
+    assert( jv == parse( R"({"a":"z","c":{"d":"e"}})" ) );
+    @endcode
+
+    @par Preconditions
+    `patch` is not `target` or an element of it.
+
+    @par Complexity
+    Linear in the size of `patch`, plus the cost
+    of copying values from `patch`.
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to `memory_resource::allocate` may throw.
+
+    @param target The value to modify.
+
+    @param patch The merge patch to apply.
+
+    @see
+        <a href="https://tools.ietf.org/html/rfc7386"
+            >RFC 7386: JSON Merge Patch</a>
+*/
+BOOST_JSON_DECL
+void
+merge_patch(
+    value& target,
+    value const& patch);
+
+/** Apply a JSON Merge Patch to a value in place.
+
+    This function modifies `target` as described
+    by the merge patch `patch`, following the
+    algorithm of RFC 7386. It is the same as the
+    overload which takes `patch` by constant
+    reference, except that values are moved out
+    of `patch` instead of being copied. When the
+    memory resources of `target` and `patch` are
+    equal, entire arrays, objects and strings are
+    transferred without allocating. Otherwise they
+    are copied.
+
+    @par Preconditions
+    `patch` is not `target` or an element of it.
+
+    @par Complexity
+    Linear in the size of `patch`.
+
+    @par Exception Safety
+    Basic guarantee.
+    Calls to `memory_resource::allocate` may throw.
+
+    @param target The value to modify.
+
+    @param patch The merge patch to apply. After
+    the call, it is left in a valid but unspecified
+    state.
+*/
+BOOST_JSON_DECL
+void
+merge_patch(
+    value& target,
+    value&& patch);
+
+BOOST_JSON_NS_END
+
+#endif
@@ -101,6 +101,102 @@ parse(
     storage_ptr sp = {},
     parse_options const& opt = {});
 
+/** Return the parsed contents of a file as a @ref value.
+
+    This function parses the entire contents of the
+    file at `path` in one step to produce a complete
+    JSON object, returned as a @ref value. On POSIX
+    systems a regular file is mapped into memory and
+    parsed directly from the mapping, without first
+    copying it into a buffer; the mapping is released
+    before the function returns. Otherwise, including
+    when the file cannot be mapped or reports no size,
+    the file is read into a temporary buffer.
+
+    If the file cannot be opened or read, `ec` is set
+    to the system error, using the generic category.
+    Otherwise, if the file does not contain a complete
+    serialized JSON, `ec` is set to the parse error.
+    In either case the returned value will be null,
+    using the default memory resource.
+
+    @par Complexity
+    Linear in the size of the file.
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to `memory_resource::allocate` may throw.
+
+    @return A value representing the parsed JSON,
+    or a null if any error occurred.
+
+    @param path The path of the file to parse.
+
+    @param ec Set to the error, if any occurred.
+
+    @param sp The memory resource that the new value and all
+    of its elements will use. If this parameter is omitted,
+    the default memory resource is used.
+
+    @param opt The options for the parser. If this parameter
+    is omitted, the parser will accept only standard JSON.
+
+    @see
+        @ref parse,
+        @ref parse_options.
+*/
+BOOST_JSON_DECL
+value
+parse_file(
+    char const* path,
+    error_code& ec,
+    storage_ptr sp = {},
+    parse_options const& opt = {});
+
+/** Return the parsed contents of a file as a @ref value.
+
+    This function parses the entire contents of the
+    file at `path` in one step to produce a complete
+    JSON object, returned as a @ref value. On POSIX
+    systems a regular file is mapped into memory and
+    parsed directly from the mapping. Otherwise, or
+    when mapping fails, the file is read into a
+    temporary buffer. If the file cannot be
+    read or does not contain a complete serialized
+    JSON, an exception is thrown.
+
+    @par Complexity
+    Linear in the size of the file.
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to `memory_resource::allocate` may throw.
+
+    @return A value representing the parsed
+    JSON upon success.
+
+    @param path The path of the file to parse.
+
+    @param sp The memory resource that the new value and all
+    of its elements will use. If this parameter is omitted,
+    the default memory resource is used.
+
+    @param opt The options for the parser. If this parameter
+    is omitted, the parser will accept only standard JSON.
+
+    @throw system_error Thrown on failure.
+
+    @see
+        @ref parse,
+        @ref parse_options.
+*/
+BOOST_JSON_DECL
+value
+parse_file(
+    char const* path,
+    storage_ptr sp = {},
+    parse_options const& opt = {});
+
 BOOST_JSON_NS_END
 
 #endif
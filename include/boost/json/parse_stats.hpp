@@ -0,0 +1,127 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_PARSE_STATS_HPP
+#define BOOST_JSON_PARSE_STATS_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <cstddef>
+
+BOOST_JSON_NS_BEGIN
+
+/** Counters describing the work done by a parser
+
+    When the macro `BOOST_JSON_PARSER_STATS` is
+    defined, @ref basic_parser keeps an instance of
+    this structure, updated as it parses and
+    returned by its `stats` member function. The
+    counters accumulate over every document parsed
+    until `reset_stats` is called, so that they can
+    be sampled periodically as metrics. Without the
+    macro, the counters and the member functions do
+    not exist and the parser is unchanged.
+
+    @note The macro changes the layout of the
+    parsers, so it must be defined the same way
+    when building the library and when including
+    its headers.
+
+    @see
+        @ref basic_parser,
+        @ref parser,
+        @ref stream_parser.
+*/
+struct parse_stats
+{
+    /** The part of the grammar where the parser suspended
+    */
+    enum class site : unsigned char
+    {
+        /// Outside of any value
+        document,
+
+        /// Inside a comment
+        comment,
+
+        /// Inside `null`, `true` or `false`
+        literal,
+
+        /// Inside a string or key
+        string,
+
+        /// Inside an escape sequence in a string or key
+        escape,
+
+        /// Between the elements of an object
+        object,
+
+        /// Between the elements of an array
+        array,
+
+        /// Inside a number
+        number,
+
+        /// Before or after a value
+        value
+    };
+
+    /// The number of values of @ref site
+    static constexpr std::size_t site_count = 9;
+
+    /** Suspensions, indexed by @ref site
+
+        A suspension happens when a buffer ends in
+        the middle of the document and the parser
+        saves its state to resume on the next write.
+    */
+    std::size_t suspensions[site_count] = {};
+
+    /// Escape sequences in strings and keys
+    std::size_t escapes = 0;
+
+    /// Numbers which were not parsed by the fast path
+    std::size_t slow_numbers = 0;
+
+    /// Calls to `on_string_part` and `on_key_part`
+    std::size_t string_parts = 0;
+
+    /// Calls to `on_number_part`
+    std::size_t number_parts = 0;
+
+    /// Calls to `on_comment_part`
+    std::size_t comment_parts = 0;
+
+    /// The deepest nesting of arrays and objects
+    std::size_t max_depth = 0;
+
+    /// Reallocations of the stack holding suspended state
+    std::size_t stack_reallocations = 0;
+
+    /** Return the suspension count for a site.
+    */
+    std::size_t&
+    suspensions_at(site s) noexcept
+    {
+        return suspensions[static_cast<
+            std::size_t>(s)];
+    }
+
+    /** Return the suspension count for a site.
+    */
+    std::size_t
+    suspensions_at(site s) const noexcept
+    {
+        return suspensions[static_cast<
+            std::size_t>(s)];
+    }
+};
+
+BOOST_JSON_NS_END
+
+#endif
@@ -396,6 +396,48 @@ public:
 #endif
 #endif
 
+#if defined(BOOST_JSON_PARSER_STATS) || defined(BOOST_JSON_DOCS)
+    /** Return the parsing statistics.
+
+        This function returns the counters which
+        describe the work done by the parser since
+        it was constructed, or since the last call
+        to @ref reset_stats. It is only available
+        when the macro `BOOST_JSON_PARSER_STATS`
+        is defined.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    parse_stats const&
+    stats() const noexcept
+    {
+        return p_.stats();
+    }
+
+    /** Reset the parsing statistics.
+
+        This function sets all of the counters
+        returned by @ref stats to zero. It is only
+        available when the macro
+        `BOOST_JSON_PARSER_STATS` is defined.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    void
+    reset_stats() noexcept
+    {
+        p_.reset_stats();
+    }
+#endif
+
     /** Reset the parser for a new JSON.
 
         This function is used to reset the parser to
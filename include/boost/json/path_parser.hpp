@@ -0,0 +1,327 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_PATH_PARSER_HPP
+#define BOOST_JSON_PATH_PARSER_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/array.hpp>
+#include <boost/json/basic_parser.hpp>
+#include <boost/json/json_path.hpp>
+#include <boost/json/parse_options.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/detail/path_handler.hpp>
+#include <cstddef>
+
+BOOST_JSON_NS_BEGIN
+
+//----------------------------------------------------------
+
+/** A parser which extracts the values matched by a JSONPath
+
+    This class parses a JSON contained in a series of one
+    or more character buffers, and evaluates a @ref json_path
+    over the parser events as they arrive. Only the values
+    which match the path are built; the rest of the document
+    is checked for validity and then discarded, so memory
+    use is bounded by the size of the matches rather than
+    the size of the document.
+\n
+    Matches are appended to the array returned by
+    @ref matches as soon as each one is complete. The caller
+    may move elements out of this array, or clear it, between
+    calls to write, to process matches while parsing
+    continues. When a match contains other matches, as can
+    happen with `..`, the outer value appears first,
+    followed by copies of the nested matches.
+
+    @par Usage
+
+    @code
+    path_parser p( json_path( "$.items[*].id" ) );
+    error_code ec;
+    while( read_some( buf ) )
+    {
+        p.write_some( buf.data(), buf.size(), ec );
+        if( ec )
+            break;
+        for( auto& jv : p.matches() )
+            process( std::move( jv ) );
+        p.matches().clear();
+    }
+    p.finish( ec );
+    @endcode
+
+    @par Thread Safety
+    Distinct instances may be accessed concurrently.
+    Non-const member functions of a shared instance
+    may not be called concurrently with any other
+    member functions of that instance.
+
+    @see
+        @ref json_path,
+        @ref stream_parser.
+*/
+class path_parser
+{
+    basic_parser<detail::path_handler> p_;
+
+public:
+    /// Copy constructor (deleted)
+    path_parser(
+        path_parser const&) = delete;
+
+    /// Copy assignment (deleted)
+    path_parser& operator=(
+        path_parser const&) = delete;
+
+    /** Destructor.
+
+        All dynamically allocated memory, including
+        any matches, is freed.
+
+        @par Complexity
+        Linear in the size of the matches.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    ~path_parser() = default;
+
+    /** Constructor.
+
+        This constructs a new parser which evaluates a copy
+        of `path`, and is configured to use the specified
+        parsing options.
+
+        @par Complexity
+        Linear in the size of `path`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param path The expression to evaluate.
+
+        @param sp The memory resource to use for the
+        matches and for temporary storage. If this
+        parameter is omitted, the default memory
+        resource is used.
+
+        @param opt The parsing options to use.
+    */
+    BOOST_JSON_DECL
+    explicit
+    path_parser(
+        json_path const& path,
+        storage_ptr sp = {},
+        parse_options const& opt = {});
+
+    /** Reset the parser for a new JSON.
+
+        This function is used to reset the parser to
+        prepare it for parsing a new complete JSON. Any
+        matches already found are kept.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    BOOST_JSON_DECL
+    void
+    reset() noexcept;
+
+    /** Return true if a complete JSON has been parsed.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    bool
+    done() const noexcept
+    {
+        return p_.done();
+    }
+
+    /** Return the matches found so far.
+
+        The returned array holds each match found since
+        construction, or since the caller last removed
+        elements from it.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    array&
+    matches() noexcept
+    {
+        return p_.handler().matches;
+    }
+
+    /** Parse a buffer containing all or part of a complete JSON.
+
+        This function parses JSON contained in the
+        specified character buffer. If parsing completes,
+        any additional characters past the end of the
+        complete JSON are ignored. The function returns
+        the actual number of characters parsed, which may
+        be less than the size of the input.
+
+        @par Complexity
+        Linear in `size`.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @return The number of characters consumed from
+        the buffer.
+
+        @param data A pointer to a buffer of `size`
+        characters to parse.
+
+        @param size The number of characters pointed to
+        by `data`.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    std::size_t
+    write_some(
+        char const* data,
+        std::size_t size,
+        error_code& ec);
+
+    BOOST_JSON_DECL
+    std::size_t
+    write_some(
+        char const* data,
+        std::size_t size);
+
+    std::size_t
+    write_some(
+        string_view s,
+        error_code& ec)
+    {
+        return write_some(
+            s.data(), s.size(), ec);
+    }
+
+    std::size_t
+    write_some(
+        string_view s)
+    {
+        return write_some(
+            s.data(), s.size());
+    }
+    /** @} */
+
+    /** Parse a buffer containing all or part of a complete JSON.
+
+        This function parses JSON contained in the
+        specified character buffer. The entire buffer
+        must be consumed; if there are additional
+        characters past the end of the complete JSON,
+        the parse fails and an error is returned.
+
+        @par Complexity
+        Linear in `size`.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @return The number of characters consumed from
+        the buffer.
+
+        @param data A pointer to a buffer of `size`
+        characters to parse.
+
+        @param size The number of characters pointed to
+        by `data`.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    std::size_t
+    write(
+        char const* data,
+        std::size_t size,
+        error_code& ec);
+
+    BOOST_JSON_DECL
+    std::size_t
+    write(
+        char const* data,
+        std::size_t size);
+
+    std::size_t
+    write(
+        string_view s,
+        error_code& ec)
+    {
+        return write(
+            s.data(), s.size(), ec);
+    }
+
+    std::size_t
+    write(
+        string_view s)
+    {
+        return write(
+            s.data(), s.size());
+    }
+    /** @} */
+
+    /** Indicate the end of JSON input.
+
+        This function is used to indicate that there
+        are no more character buffers in the current
+        JSON being parsed. If the resulting JSON is
+        incomplete, the error is set to indicate a
+        parsing failure.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    void
+    finish(error_code& ec);
+
+    BOOST_JSON_DECL
+    void
+    finish();
+    /** @} */
+};
+
+BOOST_JSON_NS_END
+
+#endif
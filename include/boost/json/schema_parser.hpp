@@ -0,0 +1,343 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_SCHEMA_PARSER_HPP
+#define BOOST_JSON_SCHEMA_PARSER_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/basic_parser.hpp>
+#include <boost/json/json_schema.hpp>
+#include <boost/json/parse_options.hpp>
+#include <boost/json/storage_ptr.hpp>
+#include <boost/json/value.hpp>
+#include <boost/json/detail/schema_handler.hpp>
+#include <cstddef>
+
+BOOST_JSON_NS_BEGIN
+
+//----------------------------------------------------------
+
+/** A DOM parser which checks the input against a JSON Schema
+
+    This class parses a JSON contained in a series of one
+    or more character buffers into a @ref value, checking
+    each parser event against a @ref json_schema as it
+    arrives. Parsing stops at the first violation, with
+    the error set to one of the schema errors, so invalid
+    input is rejected without being fully read or built.
+    A value which is returned by @ref release conforms to
+    the schema, and no second pass is needed.
+\n
+    Apart from the schema, the interface is the same as
+    that of @ref stream_parser.
+
+    @par Usage
+
+    @code
+    json_schema const schema( parse( R"({"type":"array","maxItems":100})" ) );
+    schema_parser p( schema );
+    error_code ec;
+    p.write( "[1,2,3]", ec );
+    if( ! ec )
+        p.finish( ec );
+    if( ec == condition::schema_error )
+        reject( ec );
+    value jv = p.release();
+    @endcode
+
+    @par Thread Safety
+    Distinct instances may be accessed concurrently.
+    Non-const member functions of a shared instance
+    may not be called concurrently with any other
+    member functions of that instance.
+
+    @see
+        @ref json_schema,
+        @ref stream_parser.
+*/
+class schema_parser
+{
+    basic_parser<detail::schema_handler> p_;
+
+public:
+    /// Copy constructor (deleted)
+    schema_parser(
+        schema_parser const&) = delete;
+
+    /// Copy assignment (deleted)
+    schema_parser& operator=(
+        schema_parser const&) = delete;
+
+    /** Destructor.
+
+        All dynamically allocated memory, including
+        any incomplete parsing results, is freed.
+
+        @par Complexity
+        Linear in the size of partial results
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    ~schema_parser() = default;
+
+    /** Constructor.
+
+        This constructs a new parser which checks its
+        input against a copy of `schema`, uses the
+        specified memory resource for temporary storage,
+        and is configured to use the specified parsing
+        options.
+    \n
+        The parsed value will use the default memory
+        resource for storage. To use a different resource,
+        call @ref reset after construction.
+
+        @par Complexity
+        Linear in the size of `schema`.
+
+        @par Exception Safety
+        Strong guarantee.
+        Calls to `memory_resource::allocate` may throw.
+
+        @param schema The schema to check against.
+
+        @param sp The memory resource to use for temporary
+        storage. If this parameter is omitted, the default
+        memory resource is used.
+
+        @param opt The parsing options to use.
+    */
+    BOOST_JSON_DECL
+    explicit
+    schema_parser(
+        json_schema const& schema,
+        storage_ptr sp = {},
+        parse_options const& opt = {});
+
+    /** Reset the parser for a new JSON.
+
+        This function is used to reset the parser to
+        prepare it for parsing a new complete JSON.
+        Any previous partial results are destroyed.
+
+        @par Complexity
+        Constant or linear in the size of any previous
+        partial parsing results.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param sp A pointer to the @ref memory_resource
+        to use for the resulting @ref value. The parser
+        will acquire shared ownership.
+    */
+    BOOST_JSON_DECL
+    void
+    reset(storage_ptr sp = {}) noexcept;
+
+    /** Return true if a complete JSON has been parsed.
+
+        This function returns `true` when all of these
+        conditions are met:
+
+        @li A complete serialized JSON has been
+            presented to the parser, and
+
+        @li No error has occurred since the parser
+            was constructed, or since the last call
+            to @ref reset,
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    bool
+    done() const noexcept
+    {
+        return p_.done();
+    }
+
+    /** Parse a buffer containing all or part of a complete JSON.
+
+        This function parses JSON contained in the
+        specified character buffer. If parsing completes,
+        any additional characters past the end of the
+        complete JSON are ignored. The function returns
+        the actual number of characters parsed, which may
+        be less than the size of the input.
+
+        @par Complexity
+        Linear in `size`.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @return The number of characters consumed from
+        the buffer.
+
+        @param data A pointer to a buffer of `size`
+        characters to parse.
+
+        @param size The number of characters pointed to
+        by `data`.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    std::size_t
+    write_some(
+        char const* data,
+        std::size_t size,
+        error_code& ec);
+
+    BOOST_JSON_DECL
+    std::size_t
+    write_some(
+        char const* data,
+        std::size_t size);
+
+    std::size_t
+    write_some(
+        string_view s,
+        error_code& ec)
+    {
+        return write_some(
+            s.data(), s.size(), ec);
+    }
+
+    std::size_t
+    write_some(
+        string_view s)
+    {
+        return write_some(
+            s.data(), s.size());
+    }
+    /** @} */
+
+    /** Parse a buffer containing all or part of a complete JSON.
+
+        This function parses JSON contained in the
+        specified character buffer. The entire buffer
+        must be consumed; if there are additional
+        characters past the end of the complete JSON,
+        the parse fails and an error is returned.
+
+        @par Complexity
+        Linear in `size`.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @return The number of characters consumed from
+        the buffer.
+
+        @param data A pointer to a buffer of `size`
+        characters to parse.
+
+        @param size The number of characters pointed to
+        by `data`.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    std::size_t
+    write(
+        char const* data,
+        std::size_t size,
+        error_code& ec);
+
+    BOOST_JSON_DECL
+    std::size_t
+    write(
+        char const* data,
+        std::size_t size);
+
+    std::size_t
+    write(
+        string_view s,
+        error_code& ec)
+    {
+        return write(
+            s.data(), s.size(), ec);
+    }
+
+    std::size_t
+    write(
+        string_view s)
+    {
+        return write(
+            s.data(), s.size());
+    }
+    /** @} */
+
+    /** Indicate the end of JSON input.
+
+        This function is used to indicate that there
+        are no more character buffers in the current
+        JSON being parsed. If the resulting JSON is
+        incomplete, the error is set to indicate a
+        parsing failure.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @param ec Set to the error, if any occurred.
+    */
+    /** @{ */
+    BOOST_JSON_DECL
+    void
+    finish(error_code& ec);
+
+    BOOST_JSON_DECL
+    void
+    finish();
+    /** @} */
+
+    /** Return the parsed JSON as a @ref value.
+
+        This returns the parsed value, or throws
+        an exception if the parsing is incomplete or
+        failed. It is necessary to call @ref reset
+        after calling this function in order to parse
+        another JSON.
+
+        @par Complexity
+        Constant.
+
+        @return The parsed value, which conforms
+        to the schema.
+
+        @throw system_error if a complete JSON
+        conforming to the schema has not been parsed.
+    */
+    BOOST_JSON_DECL
+    value
+    release();
+};
+
+BOOST_JSON_NS_END
+
+#endif
@@ -11,6 +11,7 @@
 #define BOOST_JSON_SERIALIZE_HPP
 
 #include <boost/json/detail/config.hpp>
+#include <boost/json/serialize_options.hpp>
 #include <boost/json/value.hpp>
 #include <iosfwd>
 #include <string>
@@ -55,6 +56,57 @@ std::string
 serialize(string_view t);
 /** @} */
 
+/** Return a string representing a serialized element.
+
+    This function serializes `t` as JSON in the
+    form given by the options, and returns it as
+    a `std::string`.
+
+    @par Example
+    @code
+    value jv = parse( "{\"b\":1e1,\"a\":[]}" );
+
+    serialize_options opts;
+    opts.canonical = true;
+    assert( serialize( jv, opts ) == "{\"a\":[],\"b\":10}" );
+    @endcode
+
+    @par Complexity
+    Constant or linear in the size of `t`.
+
+    @par Exception Safety
+    Strong guarantee.
+    Calls to allocate may throw.
+
+    @return The serialized string
+
+    @param t The value to serialize
+
+    @param opts The options for the serializer.
+
+    @see
+        @ref serialize_options.
+*/
+/** @{ */
+BOOST_JSON_DECL
+std::string
+serialize(
+    value const& t,
+    serialize_options const& opts);
+
+BOOST_JSON_DECL
+std::string
+serialize(
+    array const& t,
+    serialize_options const& opts);
+
+BOOST_JSON_DECL
+std::string
+serialize(
+    object const& t,
+    serialize_options const& opts);
+/** @} */
+
 /** Serialize an element to an output stream.
 
     This function serializes the specified element
@@ -0,0 +1,64 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_SERIALIZE_OPTIONS_HPP
+#define BOOST_JSON_SERIALIZE_OPTIONS_HPP
+
+#include <boost/json/detail/config.hpp>
+
+BOOST_JSON_NS_BEGIN
+
+/** Serializer options
+
+    This structure is used for specifying the
+    form of the serialized output. Default-constructed
+    options produce the members of objects in their
+    stored order, and numbers in the library's
+    own format.
+
+    @see
+        @ref serialize,
+        @ref serializer.
+*/
+struct serialize_options
+{
+    /** Produce the canonical form of RFC 8785
+
+        When set, the output is the JSON Canonicalization
+        Scheme (JCS) form of the value, suitable for
+        hashing and signing without a separate pass:
+
+        @li The members of each object are written in
+        the order of the UTF-16 code units of their
+        keys. The object is not modified or copied;
+        the serializer sorts pointers to its members.
+
+        @li Numbers are written in the shortest form
+        which round trips, laid out as ECMAScript's
+        `Number.prototype.toString`. Integers with a
+        magnitude above 2^53 are first converted to
+        `double`, as the scheme requires.
+
+        @li Strings are escaped as they are without
+        this option, which matches the scheme.
+
+        Infinity and NaN have no representation in
+        the scheme, and are written as `null`.
+        Duplicate keys cannot occur in an @ref object.
+
+        @see
+            <a href="https://tools.ietf.org/html/rfc8785"
+                >RFC 8785: JSON Canonicalization Scheme</a>
+    */
+    bool canonical = false;
+};
+
+BOOST_JSON_NS_END
+
+#endif
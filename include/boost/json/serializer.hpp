@@ -11,6 +11,7 @@
 #define BOOST_JSON_SERIALIZER_HPP
 
 #include <boost/json/detail/config.hpp>
+#include <boost/json/serialize_options.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/detail/format.hpp>
 #include <boost/json/detail/stack.hpp>
@@ -77,15 +78,24 @@ class serializer
     fn_t fn1_ = &serializer::write_null<false>;
     value const* jv_ = nullptr;
     detail::stack st_;
+    // sorted members of the objects being
+    // written, when producing canonical output
+    detail::stack perm_;
     const_stream cs0_;
     char buf_[detail::max_number_chars + 1];
     bool done_ = false;
+    serialize_options opts_;
 
     inline bool suspend(state st);
     inline bool suspend(
         state st, array::const_iterator it, array const* pa);
     inline bool suspend(
         state st, object::const_iterator it, object const* po);
+    inline bool suspend(
+        state st, std::size_t i, std::size_t base, object const* po);
+    inline std::size_t sort_members(object const* po);
+    inline key_value_pair const* member(
+        std::size_t base, std::size_t i) noexcept;
     template<bool StackEmpty> bool write_null   (stream& ss);
     template<bool StackEmpty> bool write_true   (stream& ss);
     template<bool StackEmpty> bool write_false  (stream& ss);
@@ -93,6 +103,7 @@ class serializer
     template<bool StackEmpty> bool write_number (stream& ss);
     template<bool StackEmpty> bool write_array  (stream& ss);
     template<bool StackEmpty> bool write_object (stream& ss);
+    template<bool StackEmpty> bool write_sorted (stream& ss);
     template<bool StackEmpty> bool write_value  (stream& ss);
     inline string_view read_some(char* dest, std::size_t size);
 
@@ -129,6 +140,45 @@ public:
     BOOST_JSON_DECL
     serializer() noexcept;
 
+    /** Constructor
+
+        This constructs a serializer with no value,
+        which produces output in the form given by
+        the specified options.
+        The value may be set later by calling @ref reset.
+        If serialization is attempted with no value,
+        the output is as if a null value is serialized.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+
+        @param opts The options for the serializer.
+
+        @see
+            @ref serialize_options.
+    */
+    BOOST_JSON_DECL
+    explicit
+    serializer(
+        serialize_options const& opts) noexcept;
+
+    /** Return the options used by the serializer
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    serialize_options const&
+    options() const noexcept
+    {
+        return opts_;
+    }
+
     /** Returns `true` if the serialization is complete
 
         This function returns `true` when all of the
@@ -31,25 +31,36 @@ in a translation unit of the program.
 #include <boost/json/impl/array.ipp>
 #include <boost/json/impl/error.ipp>
 #include <boost/json/impl/kind.ipp>
+#include <boost/json/impl/merge_patch.ipp>
+#include <boost/json/impl/json_pointer.ipp>
+#include <boost/json/impl/json_schema.ipp>
+#include <boost/json/impl/json_path.ipp>
 #include <boost/json/impl/monotonic_resource.ipp>
 #include <boost/json/impl/null_resource.ipp>
 #include <boost/json/impl/object.ipp>
 #include <boost/json/impl/parse.ipp>
 #include <boost/json/impl/parser.ipp>
+#include <boost/json/impl/path_parser.ipp>
+#include <boost/json/impl/schema_parser.ipp>
 #include <boost/json/impl/serialize.ipp>
 #include <boost/json/impl/serializer.ipp>
 #include <boost/json/impl/static_resource.ipp>
 #include <boost/json/impl/stream_parser.ipp>
 #include <boost/json/impl/string.ipp>
+#include <boost/json/impl/trace.ipp>
 #include <boost/json/impl/value.ipp>
 #include <boost/json/impl/value_stack.ipp>
 #include <boost/json/impl/value_ref.ipp>
+#include <boost/json/impl/validate.ipp>
 
 #include <boost/json/detail/impl/shared_resource.ipp>
 #include <boost/json/detail/impl/default_resource.ipp>
 #include <boost/json/detail/impl/except.ipp>
 #include <boost/json/detail/impl/format.ipp>
 #include <boost/json/detail/impl/handler.ipp>
+#include <boost/json/detail/impl/mapped_file.ipp>
+#include <boost/json/detail/impl/path_handler.ipp>
+#include <boost/json/detail/impl/schema_handler.ipp>
 #include <boost/json/detail/impl/stack.ipp>
 #include <boost/json/detail/impl/string_impl.ipp>
 
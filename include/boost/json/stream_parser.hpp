@@ -15,6 +15,8 @@
 #include <boost/json/parse_options.hpp>
 #include <boost/json/storage_ptr.hpp>
 #include <boost/json/value.hpp>
+#include <boost/json/detail/buffer.hpp>
+#include <boost/json/detail/buffers.hpp>
 #include <boost/json/detail/handler.hpp>
 #include <type_traits>
 #include <cstddef>
@@ -132,8 +134,18 @@ BOOST_JSON_NS_BEGIN
 */
 class stream_parser
 {
+    using gather_buffer = detail::buffer<
+        BOOST_JSON_STACK_BUFFER_SIZE>;
+
     basic_parser<detail::handler> p_;
 
+    BOOST_JSON_DECL
+    std::size_t
+    write_gather(
+        gather_buffer& g,
+        string_view s,
+        error_code& ec);
+
 public:
     /// Copy constructor (deleted)
     stream_parser(
@@ -417,6 +429,48 @@ public:
 #endif
 #endif
 
+#if defined(BOOST_JSON_PARSER_STATS) || defined(BOOST_JSON_DOCS)
+    /** Return the parsing statistics.
+
+        This function returns the counters which
+        describe the work done by the parser since
+        it was constructed, or since the last call
+        to @ref reset_stats. It is only available
+        when the macro `BOOST_JSON_PARSER_STATS`
+        is defined.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    parse_stats const&
+    stats() const noexcept
+    {
+        return p_.stats();
+    }
+
+    /** Reset the parsing statistics.
+
+        This function sets all of the counters
+        returned by @ref stats to zero. It is only
+        available when the macro
+        `BOOST_JSON_PARSER_STATS` is defined.
+
+        @par Complexity
+        Constant.
+
+        @par Exception Safety
+        No-throw guarantee.
+    */
+    void
+    reset_stats() noexcept
+    {
+        p_.reset_stats();
+    }
+#endif
+
     /** Reset the parser for a new JSON.
 
         This function is used to reset the parser to
@@ -878,6 +932,107 @@ public:
             s.data(), s.size());
     }
 
+    /** Parse a buffer sequence containing all or part of a complete JSON.
+
+        This function parses all or part of a JSON
+        contained in the sequence of character buffers,
+        such as a chain of network frames, as if the
+        buffers were written one after another with
+        @ref write. Segments smaller than an internal
+        buffer are gathered together, and the text
+        on either side of each segment boundary is
+        gathered up to the nearest place where one
+        token ends and the next begins, so that most
+        boundaries do not split a token. The entire
+        sequence must be consumed; if there are
+        additional characters past the end of the complete
+        JSON, the parse fails and an error is returned.
+
+        @par Example
+        @code
+        stream_parser p;                                // construct a parser
+        std::vector< string_view > v{ "[1,", "23", "4,5]" };
+        std::size_t n = p.write( v );                   // parse the segments
+        assert( n == 9 );                               // all characters consumed
+        value jv = p.release();                         // take ownership of the value
+        @endcode
+
+        @par Constraints
+        `ConstBufferSequence` is a range whose elements
+        are either convertible to @ref string_view, or
+        have members `data()` and `size()` designating a
+        contiguous range of characters, such as
+        `std::vector<char>`. Types convertible to
+        @ref string_view are not buffer sequences.
+
+        @par Complexity
+        Linear in the total size of the buffers.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @return The number of characters consumed from
+        the buffer sequence.
+
+        @param buffers The buffer sequence to parse.
+
+        @param ec Set to the error, if any occurred.
+    */
+    template<class ConstBufferSequence
+#ifndef BOOST_JSON_DOCS
+        ,class = typename std::enable_if<
+            detail::is_buffer_sequence<
+                ConstBufferSequence>::value>::type
+#endif
+    >
+    std::size_t
+    write(
+        ConstBufferSequence const& buffers,
+        error_code& ec);
+
+    /** Parse a buffer sequence containing all or part of a complete JSON.
+
+        This function parses all or part of a JSON
+        contained in the sequence of character buffers,
+        as described in the overload which takes an
+        `error_code`.
+
+        @par Constraints
+        `ConstBufferSequence` is a range whose elements
+        are either convertible to @ref string_view, or
+        have members `data()` and `size()` designating a
+        contiguous range of characters.
+
+        @par Complexity
+        Linear in the total size of the buffers.
+
+        @par Exception Safety
+        Basic guarantee.
+        Calls to `memory_resource::allocate` may throw.
+        Upon error or exception, subsequent calls will
+        fail until @ref reset is called to parse a new JSON.
+
+        @return The number of characters consumed from
+        the buffer sequence.
+
+        @param buffers The buffer sequence to parse.
+
+        @throw system_error Thrown on error.
+    */
+    template<class ConstBufferSequence
+#ifndef BOOST_JSON_DOCS
+        ,class = typename std::enable_if<
+            detail::is_buffer_sequence<
+                ConstBufferSequence>::value>::type
+#endif
+    >
+    std::size_t
+    write(
+        ConstBufferSequence const& buffers);
+
     /** Indicate the end of JSON input.
 
         This function is used to indicate that there
@@ -982,4 +1137,6 @@ public:
 
 BOOST_JSON_NS_END
 
+#include <boost/json/impl/stream_parser.hpp>
+
 #endif
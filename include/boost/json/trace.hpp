@@ -0,0 +1,159 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_TRACE_HPP
+#define BOOST_JSON_TRACE_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <cstddef>
+
+BOOST_JSON_NS_BEGIN
+
+/** The operations reported to @ref trace_hooks
+*/
+enum class trace_event : unsigned char
+{
+    /** A call to `write_some` on @ref parser or @ref stream_parser
+
+        The count is the size of the buffer when
+        the call begins, and the number of
+        characters consumed when it ends.
+    */
+    parse,
+
+    /** A call to `finish` on @ref stream_parser
+
+        The count is zero.
+    */
+    finish,
+
+    /** Building an array from the elements on a @ref value_stack
+
+        The count is the number of elements.
+    */
+    build_array,
+
+    /** Building an object from the members on a @ref value_stack
+
+        The count is the number of members.
+    */
+    build_object,
+
+    /** A call to `read` on @ref serializer
+
+        The count is the size of the buffer when
+        the call begins, and the number of
+        characters written when it ends.
+    */
+    serialize
+};
+
+/** The interface to a tracing system
+
+    When the macro `BOOST_JSON_TRACE` is defined
+    while building the library, each of the
+    operations listed in @ref trace_event calls
+    @ref on_begin before it starts and @ref on_end
+    when it returns or throws, on the hooks set with
+    @ref set_trace_hooks. This allows the time spent
+    parsing, building values and serializing to be
+    attributed by an existing tracing or profiling
+    system, for example by emitting USDT probes or
+    span events from the hooks.
+\n
+    Without the macro no calls are made and the
+    library is unchanged.
+
+    @par Thread Safety
+    The hooks are shared by all threads, and
+    may be called concurrently.
+
+    @see
+        @ref set_trace_hooks,
+        @ref trace_event.
+*/
+class trace_hooks
+{
+public:
+    /// Destructor
+    virtual
+    ~trace_hooks() = default;
+
+    /** Called when an operation begins.
+
+        @param ev The operation.
+
+        @param n A count which depends on the operation.
+    */
+    virtual
+    void
+    on_begin(
+        trace_event ev,
+        std::size_t n) noexcept = 0;
+
+    /** Called when an operation ends.
+
+        @param ev The operation.
+
+        @param n A count which depends on the operation.
+    */
+    virtual
+    void
+    on_end(
+        trace_event ev,
+        std::size_t n) noexcept = 0;
+};
+
+#if defined(BOOST_JSON_TRACE) || defined(BOOST_JSON_DOCS)
+/** Set the hooks called by traced operations.
+
+    This function replaces the hooks which are
+    called for every traced operation in the
+    process. The caller is responsible for keeping
+    the hooks alive until they are replaced and
+    no call to them is in progress. It is only
+    available when the macro `BOOST_JSON_TRACE`
+    is defined.
+
+    @par Complexity
+    Constant.
+
+    @par Exception Safety
+    No-throw guarantee.
+
+    @return The previous hooks, or `nullptr`.
+
+    @param h The hooks to call, or `nullptr`
+    to stop tracing.
+*/
+BOOST_JSON_DECL
+trace_hooks*
+set_trace_hooks(trace_hooks* h) noexcept;
+
+/** Return the hooks called by traced operations.
+
+    It is only available when the macro
+    `BOOST_JSON_TRACE` is defined.
+
+    @par Complexity
+    Constant.
+
+    @par Exception Safety
+    No-throw guarantee.
+
+    @return The current hooks, or `nullptr`.
+*/
+BOOST_JSON_DECL
+trace_hooks*
+get_trace_hooks() noexcept;
+#endif
+
+BOOST_JSON_NS_END
+
+#endif
@@ -0,0 +1,91 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+#ifndef BOOST_JSON_VALIDATE_HPP
+#define BOOST_JSON_VALIDATE_HPP
+
+#include <boost/json/detail/config.hpp>
+#include <boost/json/error.hpp>
+#include <boost/json/parse_options.hpp>
+#include <boost/json/string_view.hpp>
+
+BOOST_JSON_NS_BEGIN
+
+/** Check that a string contains a valid JSON.
+
+    This function checks an entire string in one
+    step against the JSON grammar, without producing
+    a @ref value or invoking a handler. Numbers are
+    not converted, escaped strings are not unescaped,
+    and no memory is allocated. The grammar, including
+    the extensions and the maximum nesting depth set
+    in the options, is the same one used by @ref parse.
+    Nesting deeper than 65536 levels fails with
+    @ref error::too_deep even when the options
+    allow more.
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @par Exception Safety
+    No-throw guarantee.
+
+    @return The number of characters examined. If
+    the string is valid this is equal to `s.size()`,
+    otherwise it is the offset of the character at
+    which the error was detected.
+
+    @param s The string to check.
+
+    @param ec Set to the error, if any occurred.
+
+    @param opt The options for the validator. If this
+    parameter is omitted, only standard JSON is accepted.
+
+    @see
+        @ref parse,
+        @ref parse_options.
+*/
+BOOST_JSON_DECL
+std::size_t
+validate(
+    string_view s,
+    error_code& ec,
+    parse_options const& opt = {}) noexcept;
+
+/** Return `true` if a string contains a valid JSON.
+
+    This function checks an entire string in one
+    step against the JSON grammar, without producing
+    a @ref value or invoking a handler.
+
+    @par Complexity
+    Linear in `s.size()`.
+
+    @par Exception Safety
+    No-throw guarantee.
+
+    @param s The string to check.
+
+    @param opt The options for the validator. If this
+    parameter is omitted, only standard JSON is accepted.
+
+    @see
+        @ref parse,
+        @ref parse_options.
+*/
+BOOST_JSON_DECL
+bool
+validate(
+    string_view s,
+    parse_options const& opt = {}) noexcept;
+
+BOOST_JSON_NS_END
+
+#endif
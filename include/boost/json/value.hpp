@@ -3862,6 +3862,24 @@ get<1>(key_value_pair&& kvp) noexcept
 
 #endif
 
+namespace detail {
+
+// Structural digests of a value, which are
+// equal for values which compare equal.
+BOOST_JSON_DECL
+std::size_t
+digest(value const& jv) noexcept;
+
+BOOST_JSON_DECL
+std::size_t
+digest(array const& arr) noexcept;
+
+BOOST_JSON_DECL
+std::size_t
+digest(object const& obj) noexcept;
+
+} // detail
+
 BOOST_JSON_NS_END
 
 #ifdef __clang__
@@ -3905,6 +3923,80 @@ struct tuple_element<1, ::boost::json::key_value_pair const>
     using type = ::boost::json::value const&;
 };
 
+// std::hash specializations
+
+template<>
+struct hash< ::boost::json::value >
+{
+    hash() = default;
+    hash(hash const&) = default;
+    hash& operator=(hash const&) = default;
+
+    explicit
+    hash(std::size_t salt) noexcept
+        : salt_(salt)
+    {
+    }
+
+    std::size_t
+    operator()(::boost::json::value const& jv) const noexcept
+    {
+        return ::boost::json::detail::salt_digest(
+            ::boost::json::detail::digest(jv), salt_);
+    }
+
+private:
+    std::size_t salt_ = 0;
+};
+
+template<>
+struct hash< ::boost::json::array >
+{
+    hash() = default;
+    hash(hash const&) = default;
+    hash& operator=(hash const&) = default;
+
+    explicit
+    hash(std::size_t salt) noexcept
+        : salt_(salt)
+    {
+    }
+
+    std::size_t
+    operator()(::boost::json::array const& arr) const noexcept
+    {
+        return ::boost::json::detail::salt_digest(
+            ::boost::json::detail::digest(arr), salt_);
+    }
+
+private:
+    std::size_t salt_ = 0;
+};
+
+template<>
+struct hash< ::boost::json::object >
+{
+    hash() = default;
+    hash(hash const&) = default;
+    hash& operator=(hash const&) = default;
+
+    explicit
+    hash(std::size_t salt) noexcept
+        : salt_(salt)
+    {
+    }
+
+    std::size_t
+    operator()(::boost::json::object const& obj) const noexcept
+    {
+        return ::boost::json::detail::salt_digest(
+            ::boost::json::detail::digest(obj), salt_);
+    }
+
+private:
+    std::size_t salt_ = 0;
+};
+
 } // std
 
 #endif
@@ -12,6 +12,8 @@
 
 #include <boost/json/monotonic_resource.hpp>
 
+#include <limits>
+
 #include "test.hpp"
 #include "test_suite.hpp"
 
@@ -1221,6 +1223,15 @@ public:
         BOOST_TEST(array({1,2,3}) == array({1,2,3}));
         BOOST_TEST(array({1,2,3}) != array({1,2}));
         BOOST_TEST(array({1,2,3}) != array({3,2,1}));
+
+        // NaN is unequal to itself, even
+        // in the same array
+        {
+            array const a({
+                std::numeric_limits<double>::quiet_NaN()});
+            BOOST_TEST(a != a);
+            BOOST_TEST(a != array(a));
+        }
     }
 
     void
@@ -0,0 +1,364 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/async_parse.hpp>
+
+#include "test_suite.hpp"
+
+#ifdef BOOST_JSON_HAS_COROUTINES
+
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <algorithm>
+#include <coroutine>
+
+#include "test.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class async_parse_test
+{
+public:
+    // Yields the input in pieces of a fixed size,
+    // suspending before every other piece. Suspended
+    // reads are completed by calling `run`.
+    struct source
+    {
+        string_view s;
+        std::size_t chunk;
+        std::size_t reads = 0;
+        std::coroutine_handle<> pending;
+
+        source(
+            string_view s_,
+            std::size_t chunk_) noexcept
+            : s(s_)
+            , chunk(chunk_)
+        {
+        }
+
+        struct awaiter
+        {
+            source& src;
+
+            bool
+            await_ready() const noexcept
+            {
+                return src.reads % 2 == 0;
+            }
+
+            void
+            await_suspend(
+                std::coroutine_handle<> h) noexcept
+            {
+                src.pending = h;
+            }
+
+            string_view
+            await_resume()
+            {
+                ++src.reads;
+                auto const n = (std::min)(
+                    src.chunk, src.s.size());
+                string_view const v = src.s.substr(0, n);
+                src.s.remove_prefix(n);
+                return v;
+            }
+        };
+
+        awaiter
+        read_some() noexcept
+        {
+            return { *this };
+        }
+
+        // resume pending reads until none remain
+        void
+        run()
+        {
+            while(pending)
+                std::exchange(pending, nullptr).resume();
+        }
+    };
+
+    struct throwing_source
+    {
+        struct awaiter
+        {
+            bool
+            await_ready() const noexcept
+            {
+                return true;
+            }
+
+            void
+            await_suspend(std::coroutine_handle<>) noexcept
+            {
+            }
+
+            string_view
+            await_resume()
+            {
+                throw std::bad_alloc();
+            }
+        };
+
+        awaiter
+        read_some() noexcept
+        {
+            return {};
+        }
+    };
+
+    // An eagerly started coroutine which
+    // records when it has completed.
+    struct runner
+    {
+        struct promise_type
+        {
+            runner
+            get_return_object() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never
+            initial_suspend() const noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never
+            final_suspend() const noexcept
+            {
+                return {};
+            }
+
+            void
+            return_void() noexcept
+            {
+            }
+
+            void
+            unhandled_exception()
+            {
+                throw;
+            }
+        };
+    };
+
+    static
+    runner
+    parse_into(
+        source& src,
+        value& jv,
+        error_code& ec,
+        bool& done,
+        storage_ptr sp = {})
+    {
+        jv = co_await async_parse(src, ec, std::move(sp));
+        done = true;
+    }
+
+    // initializes the value from the awaited
+    // result, so it is not copied into `mr`
+    static
+    runner
+    parse_storage(
+        source& src,
+        fail_resource& mr,
+        bool& done)
+    {
+        {
+            error_code ec;
+            value jv = co_await async_parse(src, ec, &mr);
+            BOOST_TEST(! ec);
+            BOOST_TEST(*jv.storage() == mr);
+            BOOST_TEST(*jv.at("a").storage() == mr);
+            BOOST_TEST(mr.nalloc > 0);
+        }
+        BOOST_TEST(mr.nalloc == 0);
+        done = true;
+    }
+
+    static
+    runner
+    parse_or_throw(
+        source& src,
+        value& jv,
+        bool& threw,
+        bool& done)
+    {
+        try
+        {
+            jv = co_await async_parse(src);
+        }
+        catch(system_error const&)
+        {
+            threw = true;
+        }
+        done = true;
+    }
+
+    static
+    runner
+    parse_throwing(
+        throwing_source& src,
+        bool& threw)
+    {
+        error_code ec;
+        try
+        {
+            co_await async_parse(src, ec);
+        }
+        catch(std::bad_alloc const&)
+        {
+            threw = true;
+        }
+    }
+
+    void
+    check(
+        string_view s,
+        error_code expected = {})
+    {
+        for(std::size_t chunk = 1;
+            chunk <= s.size() + 1; ++chunk)
+        {
+            source src(s, chunk);
+            value jv;
+            error_code ec;
+            bool done = false;
+            parse_into(src, jv, ec, done);
+            src.run();
+            BOOST_TEST(done);
+            BOOST_TEST(ec == expected);
+            if(ec)
+                BOOST_TEST(jv.is_null());
+            else
+                BOOST_TEST(jv == parse(s));
+        }
+    }
+
+    void
+    testParse()
+    {
+        check("{}");
+        check("[1,2,3]");
+        check(R"({"a":[true,false,null],"b":{"c":"éx"},"d":1.5e3})");
+        check("  \"a string at the root\"  ");
+        check("12345");
+        check("-0.25");
+        check("", error::incomplete);
+        check("[1,2", error::incomplete);
+        check("[1,x]", error::syntax);
+
+        // trailing characters are only seen
+        // when they share a chunk with the end
+        source src("[] x", 4);
+        value jv;
+        error_code ec;
+        bool done = false;
+        parse_into(src, jv, ec, done);
+        src.run();
+        BOOST_TEST(done);
+        BOOST_TEST(ec == error::extra_data);
+        BOOST_TEST(jv.is_null());
+    }
+
+    void
+    testEarly()
+    {
+        // the operation completes without
+        // waiting for the end of the input
+        source src("[1]  [2]", 4);
+        value jv;
+        error_code ec;
+        bool done = false;
+        parse_into(src, jv, ec, done);
+        src.run();
+        BOOST_TEST(done);
+        BOOST_TEST(! ec);
+        BOOST_TEST(serialize(jv) == "[1]");
+        BOOST_TEST(src.s == " [2]");
+
+        // a source yields one document, so the
+        // start of another in the same chunk
+        // is extra data
+        src = source("[1] [2]", 5);
+        jv = nullptr;
+        done = false;
+        parse_into(src, jv, ec, done);
+        src.run();
+        BOOST_TEST(done);
+        BOOST_TEST(ec == error::extra_data);
+        BOOST_TEST(jv.is_null());
+    }
+
+    void
+    testStorage()
+    {
+        fail_resource mr;
+        source src(R"({"a":[1,2,"three"]})", 3);
+        bool done = false;
+        parse_storage(src, mr, done);
+        src.run();
+        BOOST_TEST(done);
+    }
+
+    void
+    testThrow()
+    {
+        {
+            source src("[1,2]", 2);
+            value jv;
+            bool threw = false;
+            bool done = false;
+            parse_or_throw(src, jv, threw, done);
+            src.run();
+            BOOST_TEST(done);
+            BOOST_TEST(! threw);
+            BOOST_TEST(serialize(jv) == "[1,2]");
+        }
+        {
+            source src("[1,2", 2);
+            value jv;
+            bool threw = false;
+            bool done = false;
+            parse_or_throw(src, jv, threw, done);
+            src.run();
+            BOOST_TEST(done);
+            BOOST_TEST(threw);
+        }
+        {
+            // exceptions from the source propagate
+            throwing_source src;
+            bool threw = false;
+            parse_throwing(src, threw);
+            BOOST_TEST(threw);
+        }
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testEarly();
+        testStorage();
+        testThrow();
+    }
+};
+
+TEST_SUITE(async_parse_test, "boost.json.async_parse");
+
+BOOST_JSON_NS_END
+
+#endif
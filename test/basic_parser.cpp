@@ -412,6 +412,9 @@ public:
         bad (R"jv( " \ud---       " )jv");
         bad (R"jv( " \ud8--       " )jv");
         bad (R"jv( " \ud80-       " )jv");
+        bad (R"jv( " \u0g00       " )jv");
+        bad (R"jv( " \u00G0       " )jv");
+        bad ("\" \\u00\xe1" "0       \"");
         // invalid low surrogate
         bad (R"jv( " \ud800------ " )jv");
         bad (R"jv( " \ud800\----- " )jv");
@@ -1327,6 +1330,45 @@ public:
         check("\"\xd1\x82\"");
         check("\"\xd1\x82\xd0\xb5\xd1\x81\xd1\x82\"");
         check("\"\xc3\x0b1""and\xc3\xba\"");
+
+        // sequences at every position
+        // relative to a vector boundary
+        {
+            std::string cjk;
+            for(int i = 0; i < 16; ++i)
+                cjk += "\xe6\x97\xa5";
+            for(string_view seq : {
+                "\xc2\x80", "\xdf\xbf", "\xe0\xa0\x80",
+                "\xed\x9f\xbf", "\xef\xbf\xbf",
+                "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf" })
+            {
+                for(std::size_t i = 0; i < 40; ++i)
+                {
+                    std::string s(48, '-');
+                    s.replace(i, seq.size(),
+                        seq.data(), seq.size());
+                    good_one("\"" + s + "\"");
+                    good_one("\"" + s + s + "\"");
+                    good_one("\"" + cjk + s + "\"");
+                }
+            }
+            for(string_view seq : {
+                "\x80", "\xbf", "\xc0\x80", "\xc2\x7f",
+                "\xc2\xc2", "\xe0\x9f\x80", "\xed\xa0\x80",
+                "\xef\xbf\x7f", "\xf0\x8f\xbf\xbf",
+                "\xf4\x90\x80\x80", "\xf5\x80\x80\x80",
+                "\xf0\x90\x80", "\xff" })
+            {
+                for(std::size_t i = 0; i < 40; ++i)
+                {
+                    std::string s(48, '-');
+                    s.replace(i, seq.size(),
+                        seq.data(), seq.size());
+                    bad_one("\"" + s + "\"");
+                    bad_one("\"" + cjk + s + "\"");
+                }
+            }
+        }
     }
 
     void
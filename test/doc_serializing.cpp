@@ -7,9 +7,11 @@
 // Official repository: https://github.com/boostorg/json
 //
 
+#include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <boost/json/serializer.hpp>
 
+#include <cassert>
 #include <iostream>
 
 #include "test_suite.hpp"
@@ -39,6 +41,13 @@ std::string s = serialize( jv );
 //----------------------------------------------------------
 {
 //[doc_serializing_3
+value jv = parse( "{\"b\":1e1,\"a\":[]}" );
+
+serialize_options opts;
+opts.canonical = true;
+
+// Members are sorted, and numbers use the ECMAScript form
+assert( serialize( jv, opts ) == "{\"a\":[],\"b\":10}" );
 //]
 }
 //----------------------------------------------------------
@@ -64,6 +64,19 @@ public:
 
         check(condition::assign_error, error::not_number);
         check(condition::assign_error, error::not_exact);
+
+        check(condition::pointer_error, error::missing_slash);
+        check(condition::pointer_error, error::invalid_escape);
+        check(condition::pointer_error, error::token_not_number);
+        check(condition::pointer_error, error::not_found);
+        check(condition::pointer_error, error::value_is_scalar);
+
+        check(condition::schema_error, error::invalid_schema);
+        check(condition::schema_error, error::type_mismatch);
+        check(condition::schema_error, error::required_missing);
+        check(condition::schema_error, error::additional_property);
+        check(condition::schema_error, error::out_of_range);
+        check(condition::schema_error, error::size_out_of_range);
     
         check(error::test_failure);
     }
@@ -0,0 +1,188 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/json_path.hpp>
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <string>
+
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class json_path_test
+{
+public:
+    static
+    value
+    store()
+    {
+        return parse(R"({
+            "store": {
+                "book": [
+                    { "category": "reference", "author": "Rees",
+                      "title": "Sayings", "price": 8.95 },
+                    { "category": "fiction", "author": "Waugh",
+                      "title": "Sword", "price": 12.99 },
+                    { "category": "fiction", "author": "Melville",
+                      "title": "Moby Dick", "isbn": "0-553", "price": 8.99 },
+                    { "category": "fiction", "author": "Tolkien",
+                      "title": "The Lord", "isbn": "0-395", "price": 22.99 }
+                ],
+                "bicycle": { "color": "red", "price": 19.95 }
+            }
+        })");
+    }
+
+    void
+    check(
+        string_view path,
+        string_view expected)
+    {
+        json_path const jp(path);
+        auto const result = jp.select(store());
+        if(! BOOST_TEST(result == parse(expected)))
+            log << "  " << path << ": " << serialize(result) << "\n";
+    }
+
+    ::test_suite::log_type log;
+
+    void
+    testParse()
+    {
+        BOOST_TEST(json_path("$").size() == 0);
+        BOOST_TEST(json_path("$.a.b").size() == 2);
+        BOOST_TEST(json_path("$..a[*]['b'][\"c\"][1][1:2][::3]").size() == 7);
+        BOOST_TEST(json_path("$.*..*").size() == 2);
+
+        auto const bad = [&](string_view s, error e)
+        {
+            error_code ec;
+            json_path jp(s, ec);
+            BOOST_TEST(ec == e);
+            BOOST_TEST(jp.size() == 0);
+            BOOST_TEST_THROWS(
+                json_path{s},
+                system_error);
+        };
+        bad("",         error::syntax);
+        bad("a",        error::syntax);
+        bad("$a",       error::syntax);
+        bad("$.",       error::syntax);
+        bad("$..",      error::syntax);
+        bad("$.[0]",    error::syntax);
+        bad("$[",       error::syntax);
+        bad("$[]",      error::syntax);
+        bad("$[-1]",    error::syntax);
+        bad("$[0:1:0]", error::syntax);
+        bad("$['a]",    error::syntax);
+        bad("$['a\\x']",error::syntax);
+        bad("$[1,2]",   error::syntax);
+        bad("$[?(@.a)]",error::syntax);
+        {
+            std::string s = "$";
+            for(std::size_t i = 0; i < json_path::max_size; ++i)
+                s += ".a";
+            BOOST_TEST(json_path(s).size() == json_path::max_size);
+            s += ".a";
+            bad(s, error::too_deep);
+        }
+    }
+
+    void
+    testSpecial()
+    {
+        json_path const jp1("$.a[0]");
+        json_path jp2(jp1);
+        BOOST_TEST(jp2.size() == 2);
+        json_path jp3(std::move(jp2));
+        BOOST_TEST(jp2.size() == 0);
+        BOOST_TEST(jp3.size() == 2);
+
+        monotonic_resource mr;
+        json_path jp4("$", &mr);
+        jp4 = jp1;
+        BOOST_TEST(*jp4.storage() == mr);
+        BOOST_TEST(jp4.size() == 2);
+        jp4 = json_path("$.x.y.z");
+        BOOST_TEST(*jp4.storage() == mr);
+        BOOST_TEST(jp4.size() == 3);
+        value const jv = parse(R"({"x":{"y":{"z":1}}})");
+        BOOST_TEST(serialize(jp4.select(jv)) == "[1]");
+    }
+
+    void
+    testSelect()
+    {
+        check("$.store.bicycle.color",  R"(["red"])");
+        check("$['store']['bicycle']",  R"([{"color":"red","price":19.95}])");
+        check("$.store.book[*].author",
+            R"(["Rees","Waugh","Melville","Tolkien"])");
+        check("$..author",
+            R"(["Rees","Waugh","Melville","Tolkien"])");
+        check("$.store.*.price",        R"([19.95])");
+        check("$..price",
+            R"([8.95,12.99,8.99,22.99,19.95])");
+        check("$..book[2].title",       R"(["Moby Dick"])");
+        check("$..book[0:2].title",     R"(["Sayings","Sword"])");
+        check("$..book[:2].author",     R"(["Rees","Waugh"])");
+        check("$..book[1:].author",     R"(["Waugh","Melville","Tolkien"])");
+        check("$..book[::2].author",    R"(["Rees","Melville"])");
+        check("$..book[1::2].author",   R"(["Waugh","Tolkien"])");
+        check("$..isbn",                R"(["0-553","0-395"])");
+        check("$..book[9]",             R"([])");
+        check("$.store.book.author",    R"([])");
+        check("$.nothing",              R"([])");
+        check("$.store..color",         R"(["red"])");
+
+        // nested matches follow the value containing them
+        {
+            value const jv = parse(R"({"a":{"a":{"a":1}},"b":[{"a":2}]})");
+            BOOST_TEST(serialize(json_path("$..a").select(jv)) ==
+                R"([{"a":{"a":1}},{"a":1},1,2])");
+            BOOST_TEST(serialize(json_path("$..*").select(jv)) ==
+                R"([{"a":{"a":1}},{"a":1},1,[{"a":2}],{"a":2},2])");
+        }
+
+        // the root
+        {
+            value const jv = parse("[1,2]");
+            BOOST_TEST(serialize(json_path("$").select(jv)) == "[[1,2]]");
+            BOOST_TEST(serialize(json_path("$[1]").select(jv)) == "[2]");
+            BOOST_TEST(serialize(json_path("$.*").select(jv)) == "[1,2]");
+        }
+
+        // quoted names
+        {
+            value const jv = parse(R"({"a.b":1,"c'd":2,"e\"f":3,"g\\h":4," ":5})");
+            BOOST_TEST(serialize(json_path("$['a.b']").select(jv)) == "[1]");
+            BOOST_TEST(serialize(json_path("$['c\\'d']").select(jv)) == "[2]");
+            BOOST_TEST(serialize(json_path("$[\"e\\\"f\"]").select(jv)) == "[3]");
+            BOOST_TEST(serialize(json_path("$['g\\\\h']").select(jv)) == "[4]");
+            BOOST_TEST(serialize(json_path("$[' ']").select(jv)) == "[5]");
+        }
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testSpecial();
+        testSelect();
+    }
+};
+
+TEST_SUITE(json_path_test, "boost.json.json_path");
+
+BOOST_JSON_NS_END
@@ -0,0 +1,237 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/json_pointer.hpp>
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <string>
+
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class json_pointer_test
+{
+public:
+    // the example document from RFC 6901
+    static
+    value
+    rfc_doc()
+    {
+        return parse(R"({
+            "foo": ["bar", "baz"],
+            "": 0,
+            "a/b": 1,
+            "c%d": 2,
+            "e^f": 3,
+            "g|h": 4,
+            "i\\j": 5,
+            "k\"l": 6,
+            " ": 7,
+            "m~n": 8
+        })");
+    }
+
+    void
+    testParse()
+    {
+        // empty
+        {
+            json_pointer const jp("");
+            BOOST_TEST(jp.empty());
+            BOOST_TEST(jp.size() == 0);
+        }
+
+        // tokens
+        {
+            json_pointer const jp("/a~1b/~0/x~01/");
+            BOOST_TEST(jp.size() == 4);
+            BOOST_TEST(jp[0] == "a/b");
+            BOOST_TEST(jp[1] == "~");
+            BOOST_TEST(jp[2] == "x~1");
+            BOOST_TEST(jp[3] == "");
+        }
+
+        // errors
+        {
+            error_code ec;
+            json_pointer jp("a", ec);
+            BOOST_TEST(ec == error::missing_slash);
+            BOOST_TEST(ec == condition::pointer_error);
+            BOOST_TEST(jp.empty());
+        }
+        {
+            error_code ec;
+            json_pointer jp("/a~2", ec);
+            BOOST_TEST(ec == error::invalid_escape);
+        }
+        {
+            error_code ec;
+            json_pointer jp("/a~", ec);
+            BOOST_TEST(ec == error::invalid_escape);
+        }
+        BOOST_TEST_THROWS(
+            json_pointer("x"),
+            system_error);
+    }
+
+    void
+    testSpecial()
+    {
+        json_pointer const jp1("/a/b");
+        {
+            json_pointer jp2(jp1);
+            BOOST_TEST(jp2.size() == 2);
+            BOOST_TEST(jp2[1] == "b");
+            json_pointer jp3(std::move(jp2));
+            BOOST_TEST(jp2.empty());
+            BOOST_TEST(jp3[0] == "a");
+        }
+        {
+            monotonic_resource mr;
+            json_pointer jp2("/x", &mr);
+            BOOST_TEST(*jp2.storage() == mr);
+            jp2 = jp1;
+            BOOST_TEST(*jp2.storage() == mr);
+            BOOST_TEST(jp2[1] == "b");
+            json_pointer jp3("/y");
+            jp2 = std::move(jp3);
+            BOOST_TEST(*jp2.storage() == mr);
+            BOOST_TEST(jp2.size() == 1);
+            BOOST_TEST(jp2[0] == "y");
+            jp2 = jp2;
+            BOOST_TEST(jp2[0] == "y");
+        }
+    }
+
+    void
+    testFind()
+    {
+        // RFC 6901 section 5
+        value const jv = rfc_doc();
+        BOOST_TEST(json_pointer("").at(jv) == jv);
+        BOOST_TEST(json_pointer("/foo").at(jv) ==
+            parse(R"(["bar","baz"])"));
+        BOOST_TEST(json_pointer("/foo/0").at(jv) == "bar");
+        BOOST_TEST(json_pointer("/").at(jv) == 0);
+        BOOST_TEST(json_pointer("/a~1b").at(jv) == 1);
+        BOOST_TEST(json_pointer("/c%d").at(jv) == 2);
+        BOOST_TEST(json_pointer("/e^f").at(jv) == 3);
+        BOOST_TEST(json_pointer("/g|h").at(jv) == 4);
+        BOOST_TEST(json_pointer("/i\\j").at(jv) == 5);
+        BOOST_TEST(json_pointer("/k\"l").at(jv) == 6);
+        BOOST_TEST(json_pointer("/ ").at(jv) == 7);
+        BOOST_TEST(json_pointer("/m~0n").at(jv) == 8);
+
+        auto const check = [&](
+            string_view s, error e)
+        {
+            error_code ec;
+            BOOST_TEST(json_pointer(s).find(jv, ec) == nullptr);
+            BOOST_TEST(ec == e);
+            BOOST_TEST(json_pointer(s).find(jv) == nullptr);
+            BOOST_TEST_THROWS(
+                json_pointer(s).at(jv),
+                system_error);
+        };
+        check("/x",         error::not_found);
+        check("/foo/2",     error::not_found);
+        check("/foo/-",     error::not_found);
+        check("/foo/01",    error::token_not_number);
+        check("/foo/x",     error::token_not_number);
+        check("/foo/",      error::token_not_number);
+        check("/foo/99999999999999999999999", error::not_found);
+        check("/a~1b/c",    error::value_is_scalar);
+
+        // mutable
+        value jv2 = rfc_doc();
+        *json_pointer("/foo/1").find(jv2) = "qux";
+        json_pointer("/m~0n").at(jv2) = 9;
+        BOOST_TEST(jv2.at("foo").at(1) == "qux");
+        BOOST_TEST(jv2.at("m~n") == 9);
+    }
+
+    void
+    testLargeObject()
+    {
+        // large enough to use the hash table
+        value jv = object();
+        for(int i = 0; i < 1000; ++i)
+            jv.get_object().emplace(
+                std::to_string(i), i);
+        for(int i = 0; i < 1000; i += 37)
+        {
+            json_pointer const jp(
+                "/" + std::to_string(i));
+            auto p = jp.find(jv);
+            if(BOOST_TEST(p))
+                BOOST_TEST(*p == i);
+        }
+        BOOST_TEST(! json_pointer("/1000").find(jv));
+
+        // the same pointer on different objects
+        json_pointer const jp("/500");
+        value jv2 = jv;
+        BOOST_TEST(jp.at(jv) == 500);
+        BOOST_TEST(jp.at(jv2) == 500);
+    }
+
+    void
+    testEmplace()
+    {
+        {
+            value jv;
+            json_pointer("/a/b/0/c").emplace(jv) = 1;
+            BOOST_TEST(serialize(jv) ==
+                R"({"a":{"b":[{"c":1}]}})");
+            json_pointer("/a/b/-").emplace(jv) = 2;
+            json_pointer("/a/b/2").emplace(jv) = 3;
+            json_pointer("/a/b/0/c").emplace(jv) = 4;
+            BOOST_TEST(serialize(jv) ==
+                R"({"a":{"b":[{"c":4},2,3]}})");
+        }
+        {
+            value jv;
+            BOOST_TEST(&json_pointer("").emplace(jv) == &jv);
+        }
+        {
+            value jv = parse(R"({"a":[1],"b":true})");
+            error_code ec;
+            BOOST_TEST(! json_pointer("/a/2").emplace(jv, ec));
+            BOOST_TEST(ec == error::not_found);
+            BOOST_TEST(! json_pointer("/a/x").emplace(jv, ec));
+            BOOST_TEST(ec == error::token_not_number);
+            BOOST_TEST(! json_pointer("/b/x").emplace(jv, ec));
+            BOOST_TEST(ec == error::value_is_scalar);
+            BOOST_TEST_THROWS(
+                json_pointer("/b/x").emplace(jv),
+                system_error);
+            BOOST_TEST(serialize(jv) == R"({"a":[1],"b":true})");
+        }
+    }
+
+    void
+    run()
+    {
+        testParse();
+        testSpecial();
+        testFind();
+        testLargeObject();
+        testEmplace();
+    }
+};
+
+TEST_SUITE(json_pointer_test, "boost.json.json_pointer");
+
+BOOST_JSON_NS_END
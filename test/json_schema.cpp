@@ -0,0 +1,269 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/json_schema.hpp>
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse.hpp>
+
+#include <string>
+
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class json_schema_test
+{
+public:
+    ::test_suite::log_type log;
+
+    void
+    check(
+        string_view schema,
+        string_view s,
+        error_code const& expected = {})
+    {
+        json_schema const js(parse(schema));
+        error_code ec;
+        js.validate(parse(s), ec);
+        if(! BOOST_TEST(ec == expected))
+            log << "  " << schema << " " << s <<
+                ": " << ec.message() << "\n";
+        if(expected)
+        {
+            BOOST_TEST_THROWS(
+                js.validate(parse(s)),
+                system_error);
+        }
+        else
+        {
+            js.validate(parse(s));
+        }
+    }
+
+    void
+    testCompile()
+    {
+        auto const good = [&](string_view s)
+        {
+            error_code ec;
+            json_schema js(parse(s), ec);
+            BOOST_TEST(! ec);
+        };
+        auto const bad = [&](string_view s)
+        {
+            error_code ec;
+            json_schema js(parse(s), ec);
+            BOOST_TEST(ec == error::invalid_schema);
+            BOOST_TEST_THROWS(
+                json_schema{parse(s)},
+                system_error);
+        };
+        good("true");
+        good("false");
+        good("{}");
+        good(R"({"$schema":"x","title":"t","description":"d","default":1,"examples":[]})");
+        good(R"({"type":["null","boolean","integer","number","string","array","object"]})");
+        good(R"({"properties":{"a":{},"b":true},"required":["a","c"]})");
+        good(R"({"minLength":2.0,"maxItems":18446744073709551615})");
+        bad("null");
+        bad("1");
+        bad("[]");
+        bad(R"({"type":"float"})");
+        bad(R"({"type":[]})");
+        bad(R"({"type":1})");
+        bad(R"({"properties":[]})");
+        bad(R"({"properties":{"a":1}})");
+        bad(R"({"required":"a"})");
+        bad(R"({"required":[1]})");
+        bad(R"({"required":["a","a"]})");
+        bad(R"({"items":[{}]})");
+        bad(R"({"items":{"type":"x"}})");
+        bad(R"({"additionalProperties":null})");
+        bad(R"({"minimum":"1"})");
+        bad(R"({"exclusiveMinimum":true})");
+        bad(R"({"minLength":-1})");
+        bad(R"({"maxItems":1.5})");
+        bad(R"({"pattern":"^a"})");
+        bad(R"({"$ref":"#"})");
+        {
+            std::string s = R"({"required":[)";
+            for(int i = 0; i < 65; ++i)
+            {
+                if(i)
+                    s += ',';
+                s += '"' + std::to_string(i) + '"';
+            }
+            s += "]}";
+            bad(s);
+        }
+    }
+
+    void
+    testSpecial()
+    {
+        json_schema const js1(parse(R"({"type":"string"})"));
+        json_schema js2(js1);
+        BOOST_TEST_THROWS(js2.validate(1), system_error);
+        json_schema js3(std::move(js2));
+        BOOST_TEST_THROWS(js3.validate(1), system_error);
+        js2.validate(1);
+
+        monotonic_resource mr;
+        json_schema js4(true, &mr);
+        js4.validate(1);
+        js4 = js1;
+        BOOST_TEST(*js4.storage() == mr);
+        BOOST_TEST_THROWS(js4.validate(1), system_error);
+        js4 = json_schema(parse(R"({"type":"integer"})"));
+        BOOST_TEST(*js4.storage() == mr);
+        js4.validate(1);
+        js4 = json_schema();
+        js4.validate("x");
+    }
+
+    void
+    testValidate()
+    {
+        // type
+        check("true", "[1,{}]");
+        check("false", "null", error::type_mismatch);
+        check(R"({"type":"null"})", "null");
+        check(R"({"type":"null"})", "false", error::type_mismatch);
+        check(R"({"type":"boolean"})", "true");
+        check(R"({"type":"boolean"})", "0", error::type_mismatch);
+        check(R"({"type":"integer"})", "-1");
+        check(R"({"type":"integer"})", "18446744073709551615");
+        check(R"({"type":"integer"})", "2.0");
+        check(R"({"type":"integer"})", "2.5", error::type_mismatch);
+        check(R"({"type":"number"})", "2.5");
+        check(R"({"type":"number"})", "\"2\"", error::type_mismatch);
+        check(R"({"type":"string"})", "\"\"");
+        check(R"({"type":"string"})", "[]", error::type_mismatch);
+        check(R"({"type":"array"})", "[]");
+        check(R"({"type":"array"})", "{}", error::type_mismatch);
+        check(R"({"type":"object"})", "{}");
+        check(R"({"type":"object"})", "[]", error::type_mismatch);
+        check(R"({"type":["string","null"]})", "null");
+        check(R"({"type":["string","null"]})", "1", error::type_mismatch);
+
+        // ranges
+        check(R"({"minimum":1})", "1");
+        check(R"({"minimum":1})", "0", error::out_of_range);
+        check(R"({"minimum":1})", "0.5", error::out_of_range);
+        check(R"({"minimum":1})", "\"0\"");
+        check(R"({"exclusiveMinimum":1})", "1", error::out_of_range);
+        check(R"({"exclusiveMinimum":1})", "1.5");
+        check(R"({"minimum":1,"exclusiveMinimum":1})", "1", error::out_of_range);
+        check(R"({"minimum":2,"exclusiveMinimum":1})", "1.5", error::out_of_range);
+        check(R"({"maximum":-1})", "-1");
+        check(R"({"maximum":-1})", "0", error::out_of_range);
+        check(R"({"maximum":-1})", "18446744073709551615", error::out_of_range);
+        check(R"({"exclusiveMaximum":0})", "0", error::out_of_range);
+        check(R"({"exclusiveMaximum":0})", "-0.1");
+        check(R"({"maximum":9223372036854775807})", "9223372036854775807");
+        check(R"({"maximum":9223372036854775807})", "9223372036854775808",
+            error::out_of_range);
+        check(R"({"minimum":18446744073709551615})", "18446744073709551615");
+        check(R"({"minimum":18446744073709551615})", "-1", error::out_of_range);
+        check(R"({"maximum":1.5})", "1");
+        check(R"({"maximum":1.5})", "2", error::out_of_range);
+
+        // sizes
+        check(R"({"minLength":2,"maxLength":3})", "\"ab\"");
+        check(R"({"minLength":2,"maxLength":3})", "\"abc\"");
+        check(R"({"minLength":2,"maxLength":3})", "\"a\"",
+            error::size_out_of_range);
+        check(R"({"minLength":2,"maxLength":3})", "\"abcd\"",
+            error::size_out_of_range);
+        check(R"({"maxLength":2})", "\"\xc3\xa9\xe2\x82\xac\"");
+        check(R"({"maxLength":1})", "\"\\ud83d\\ude00\"");
+        check(R"({"minItems":1,"maxItems":2})", "[1]");
+        check(R"({"minItems":1,"maxItems":2})", "[]",
+            error::size_out_of_range);
+        check(R"({"minItems":1,"maxItems":2})", "[1,2,3]",
+            error::size_out_of_range);
+        check(R"({"minProperties":1,"maxProperties":1})", R"({"a":1})");
+        check(R"({"minProperties":1,"maxProperties":1})", "{}",
+            error::size_out_of_range);
+        check(R"({"minProperties":1,"maxProperties":1})", R"({"a":1,"b":2})",
+            error::size_out_of_range);
+
+        // objects
+        string_view const person = R"({
+            "type": "object",
+            "properties": {
+                "id": { "type": "integer", "minimum": 1 },
+                "name": { "type": "string", "maxLength": 8 },
+                "tags": { "type": "array", "items": { "type": "string" } }
+            },
+            "required": ["id", "name"],
+            "additionalProperties": false
+        })";
+        check(person, R"({"id":1,"name":"x"})");
+        check(person, R"({"name":"x","id":1,"tags":[]})");
+        check(person, R"({"id":1})", error::required_missing);
+        check(person, R"({"name":"x"})", error::required_missing);
+        check(person, R"({"id":0,"name":"x"})", error::out_of_range);
+        check(person, R"({"id":1,"name":"123456789"})",
+            error::size_out_of_range);
+        check(person, R"({"id":1,"name":"x","tags":["a",1]})",
+            error::type_mismatch);
+        check(person, R"({"id":1,"name":"x","age":1})",
+            error::additional_property);
+        check(person, R"({"id":1,"age":1})", error::additional_property);
+        check(R"({"additionalProperties":{"type":"integer"}})",
+            R"({"a":1,"b":2})");
+        check(R"({"additionalProperties":{"type":"integer"}})",
+            R"({"a":1,"b":"2"})", error::type_mismatch);
+        check(R"({"properties":{"a":false}})", R"({"b":1})");
+        check(R"({"properties":{"a":false}})", R"({"a":1})",
+            error::type_mismatch);
+        check(R"({"required":["a"]})", R"([])");
+        {
+            std::string schema = R"({"required":[)";
+            std::string doc = "{";
+            for(int i = 0; i < 64; ++i)
+            {
+                if(i)
+                {
+                    schema += ',';
+                    doc += ',';
+                }
+                schema += '"' + std::to_string(i) + '"';
+                doc += '"' + std::to_string(i) + "\":" +
+                    std::to_string(i);
+            }
+            schema += "]}";
+            check(schema, doc + "}");
+            check(schema, doc + ",\"x\":1}");
+            doc.replace(1, 3, "\"x\"");
+            check(schema, doc + "}", error::required_missing);
+        }
+
+        // nested
+        check(R"({"items":{"items":{"type":"integer"}}})", "[[1],[2,3]]");
+        check(R"({"items":{"items":{"type":"integer"}}})", "[[1],[2,true]]",
+            error::type_mismatch);
+    }
+
+    void
+    run()
+    {
+        testCompile();
+        testSpecial();
+        testValidate();
+    }
+};
+
+TEST_SUITE(json_schema_test, "boost.json.json_schema");
+
+BOOST_JSON_NS_END
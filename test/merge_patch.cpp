@@ -0,0 +1,156 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/merge_patch.hpp>
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse.hpp>
+
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class merge_patch_test
+{
+public:
+    void
+    check(
+        string_view target,
+        string_view patch,
+        string_view result)
+    {
+        auto const expected = parse(result);
+        {
+            auto jv = parse(target);
+            auto const p = parse(patch);
+            merge_patch(jv, p);
+            BOOST_TEST(jv == expected);
+            // the patch is not modified
+            BOOST_TEST(p == parse(patch));
+        }
+        {
+            auto jv = parse(target);
+            merge_patch(jv, parse(patch));
+            BOOST_TEST(jv == expected);
+        }
+    }
+
+    void
+    testRFC()
+    {
+        // RFC 7386 appendix A
+        check(R"({"a":"b"})", R"({"a":"c"})", R"({"a":"c"})");
+        check(R"({"a":"b"})", R"({"b":"c"})", R"({"a":"b","b":"c"})");
+        check(R"({"a":"b"})", R"({"a":null})", R"({})");
+        check(R"({"a":"b","b":"c"})", R"({"a":null})", R"({"b":"c"})");
+        check(R"({"a":["b"]})", R"({"a":"c"})", R"({"a":"c"})");
+        check(R"({"a":"c"})", R"({"a":["b"]})", R"({"a":["b"]})");
+        check(R"({"a":{"b":"c"}})", R"({"a":{"b":"d","c":null}})",
+            R"({"a":{"b":"d"}})");
+        check(R"({"a":[{"b":"c"}]})", R"({"a":[1]})", R"({"a":[1]})");
+        check(R"(["a","b"])", R"(["c","d"])", R"(["c","d"])");
+        check(R"({"a":"b"})", R"(["c"])", R"(["c"])");
+        check(R"({"a":"foo"})", R"(null)", R"(null)");
+        check(R"({"a":"foo"})", R"("bar")", R"("bar")");
+        check(R"({"e":null})", R"({"a":1})", R"({"e":null,"a":1})");
+        check(R"([1,2])", R"({"a":"b","c":null})", R"({"a":"b"})");
+        check(R"({})", R"({"a":{"bb":{"ccc":null}}})", R"({"a":{"bb":{}}})");
+    }
+
+    void
+    testNested()
+    {
+        // nulls in new members are removed
+        check(R"({})", R"({"a":{"b":1,"c":{"d":null}}})",
+            R"({"a":{"b":1,"c":{}}})");
+        check(R"({"a":1})", R"({"a":{"b":null}})", R"({"a":{}})");
+        check(R"([])", R"({"a":{"b":{"c":{"d":null,"e":1},"f":null}},"g":null})",
+            R"({"a":{"b":{"c":{"e":1}}}})");
+
+        // nulls in arrays are kept
+        check(R"({})", R"({"a":[null,{"b":null}]})",
+            R"({"a":[null,{"b":null}]})");
+
+        // removing a missing member
+        check(R"({"a":1})", R"({"b":null})", R"({"a":1})");
+
+        // untouched members
+        check(R"({"a":{"b":[1,2],"c":3},"d":4})", R"({"a":{"c":5}})",
+            R"({"a":{"b":[1,2],"c":5},"d":4})");
+    }
+
+    void
+    testMove()
+    {
+        // subtrees are moved when
+        // the resources are equal
+        {
+            value jv = parse(R"({"a":1,"b":2})");
+            value p = parse(
+                R"({"a":[1,2,3],"c":{"d":"a long string to allocate"}})");
+            auto const pa = p.at("a").get_array().data();
+            auto const pc = p.at("c").get_object().begin();
+            merge_patch(jv, std::move(p));
+            BOOST_TEST(jv == parse(
+                R"({"a":[1,2,3],"b":2,"c":{"d":"a long string to allocate"}})"));
+            BOOST_TEST(jv.at("a").get_array().data() == pa);
+            BOOST_TEST(jv.at("c").get_object().begin() == pc);
+        }
+
+        // and copied otherwise
+        {
+            monotonic_resource mr;
+            value jv = parse(R"({"a":1})", &mr);
+            value p = parse(R"({"b":[1,2,3]})");
+            auto const pb = p.at("b").get_array().data();
+            merge_patch(jv, std::move(p));
+            BOOST_TEST(jv == parse(R"({"a":1,"b":[1,2,3]})"));
+            BOOST_TEST(jv.at("b").get_array().data() != pb);
+            BOOST_TEST(*jv.at("b").storage() == *jv.storage());
+        }
+
+        // values take the resource of the target
+        {
+            monotonic_resource mr;
+            value jv = parse(R"({"a":1})", &mr);
+            merge_patch(jv, parse(R"({"b":{"c":{"d":null}}})"));
+            BOOST_TEST(jv == parse(R"({"a":1,"b":{"c":{}}})"));
+            BOOST_TEST(*jv.at("b").storage() == *jv.storage());
+            BOOST_TEST(*jv.at("b").at("c").storage() == *jv.storage());
+        }
+    }
+
+    void
+    testErase()
+    {
+        // removing members does not reallocate
+        value jv = parse(R"({"a":1,"b":2,"c":3,"d":4})");
+        auto const cap = jv.get_object().capacity();
+        auto const p = jv.get_object().begin();
+        merge_patch(jv, parse(R"({"a":null,"c":null})"));
+        BOOST_TEST(jv == parse(R"({"b":2,"d":4})"));
+        BOOST_TEST(jv.get_object().capacity() == cap);
+        BOOST_TEST(jv.get_object().begin() == p);
+    }
+
+    void
+    run()
+    {
+        testRFC();
+        testNested();
+        testMove();
+        testErase();
+    }
+};
+
+TEST_SUITE(merge_patch_test, "boost.json.merge_patch");
+
+BOOST_JSON_NS_END
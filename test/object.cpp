@@ -15,6 +15,7 @@
 #include <boost/json/serialize.hpp>
 
 #include <cmath>
+#include <limits>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -1467,6 +1468,35 @@ public:
         BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) == object({{"1",1},{"2",2},{"3",3}}));
         BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) != object({{"1",1},{"2",2}}));
         BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) == object({{"3",3},{"2",2},{"1",1}}));
+
+        // same order up to a point
+        BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) == object({{"1",1},{"3",3},{"2",2}}));
+        BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) != object({{"1",1},{"3",3},{"2",4}}));
+        BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) != object({{"1",1},{"3",3},{"4",2}}));
+        BOOST_TEST(object({{"1",1},{"2",2},{"3",3}}) != object({{"1",2},{"2",2},{"3",3}}));
+
+        // large enough for a hash table
+        {
+            object o1;
+            object o2;
+            for(int i = 0; i < 100; ++i)
+            {
+                o1.emplace(std::to_string(i), i);
+                o2.emplace(std::to_string(99 - i), 99 - i);
+            }
+            BOOST_TEST(o1 == o2);
+            o2["50"] = 51;
+            BOOST_TEST(o1 != o2);
+        }
+
+        // itself
+        {
+            object const o({{"1",1},{"2",{{"3",3}}}});
+            BOOST_TEST(o == o);
+            object const n({{"1",
+                std::numeric_limits<double>::quiet_NaN()}});
+            BOOST_TEST(n != n);
+        }
     }
 
     void
@@ -10,8 +10,10 @@
 // Test that header file is self-contained.
 #include <boost/json/parse.hpp>
 
+#include <boost/json/monotonic_resource.hpp>
 #include <boost/json/serialize.hpp>
 
+#include <cstdio>
 #include <string>
 
 #include "test.hpp"
@@ -138,11 +140,93 @@ public:
         }
     }
 
+    // write `s` to a temporary file
+    static
+    std::string
+    make_file(string_view s)
+    {
+        std::string path = "boost_json_parse_file.json";
+        std::FILE* f = std::fopen(path.c_str(), "wb");
+        BOOST_TEST(f);
+        if(f)
+        {
+            std::fwrite(s.data(), 1, s.size(), f);
+            std::fclose(f);
+        }
+        return path;
+    }
+
+    void
+    testParseFile()
+    {
+        {
+            auto const path = make_file(R"({"a":[1,2,3],"b":"x"})");
+            error_code ec;
+            auto jv = parse_file(path.c_str(), ec);
+            BOOST_TEST(! ec);
+            BOOST_TEST(serialize(jv) == R"({"a":[1,2,3],"b":"x"})");
+
+            monotonic_resource mr;
+            auto const jv2 = parse_file(path.c_str(), &mr);
+            BOOST_TEST(*jv2.storage() == mr);
+            std::remove(path.c_str());
+        }
+
+        // larger than a page, ending at the end of the file
+        {
+            std::string s = "[";
+            while(s.size() < 100000)
+                s += "12345,";
+            s += "0]";
+            auto const path = make_file(s);
+            auto const jv = parse_file(path.c_str());
+            BOOST_TEST(jv.as_array().back() == 0);
+            std::remove(path.c_str());
+        }
+
+        // options
+        {
+            auto const path = make_file("[1,]");
+            parse_options opt;
+            opt.allow_trailing_commas = true;
+            BOOST_TEST(parse_file(
+                path.c_str(), {}, opt) == parse("[1]"));
+            error_code ec;
+            parse_file(path.c_str(), ec);
+            BOOST_TEST(ec == error::syntax);
+            std::remove(path.c_str());
+        }
+
+        // empty file
+        {
+            auto const path = make_file("");
+            error_code ec;
+            auto const jv = parse_file(path.c_str(), ec);
+            BOOST_TEST(ec == error::incomplete);
+            BOOST_TEST(jv.is_null());
+            std::remove(path.c_str());
+        }
+
+        // missing file
+        {
+            error_code ec;
+            auto const jv = parse_file(
+                "boost_json_no_such_file.json", ec);
+            BOOST_TEST(ec);
+            BOOST_TEST(ec.category() == generic_category());
+            BOOST_TEST(jv.is_null());
+            BOOST_TEST_THROWS(parse_file(
+                "boost_json_no_such_file.json"),
+                system_error);
+        }
+    }
+
     void
     run()
     {
         testParse();
         testMemoryUsage();
+        testParseFile();
     }
 };
 
@@ -0,0 +1,145 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/parse_stats.hpp>
+
+#include <boost/json/parser.hpp>
+#include <boost/json/stream_parser.hpp>
+
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+/*
+    The counters only exist when the library is
+    built with BOOST_JSON_PARSER_STATS, which is
+    done by a separate test target.
+*/
+
+class parse_stats_test
+{
+public:
+    using site = parse_stats::site;
+
+    std::size_t
+    suspensions(parse_stats const& st)
+    {
+        std::size_t n = 0;
+        for(auto v : st.suspensions)
+            n += v;
+        return n;
+    }
+
+    void
+    testDefault()
+    {
+        parse_stats st;
+        BOOST_TEST(suspensions(st) == 0);
+        BOOST_TEST(st.escapes == 0);
+        BOOST_TEST(st.slow_numbers == 0);
+        BOOST_TEST(st.string_parts == 0);
+        BOOST_TEST(st.number_parts == 0);
+        BOOST_TEST(st.comment_parts == 0);
+        BOOST_TEST(st.max_depth == 0);
+        BOOST_TEST(st.stack_reallocations == 0);
+        ++st.suspensions_at(site::value);
+        BOOST_TEST(st.suspensions[static_cast<
+            std::size_t>(site::value)] == 1);
+    }
+
+#ifdef BOOST_JSON_PARSER_STATS
+    void
+    testSuspensions()
+    {
+        stream_parser p;
+        p.write("[1,2");
+        BOOST_TEST(p.stats().suspensions_at(site::number) == 1);
+        BOOST_TEST(p.stats().number_parts == 1);
+        BOOST_TEST(p.stats().stack_reallocations == 1);
+        p.write(",\"abc");
+        BOOST_TEST(p.stats().suspensions_at(site::string) == 1);
+        BOOST_TEST(p.stats().string_parts == 1);
+        p.write("def\"");
+        BOOST_TEST(p.stats().suspensions_at(site::array) == 1);
+        p.write("]");
+        p.finish();
+        // a complete document waiting for
+        // whitespace is not counted
+        BOOST_TEST(suspensions(p.stats()) == 3);
+        BOOST_TEST(p.stats().max_depth == 1);
+
+        // the stack is reused
+        p.reset();
+        p.write("[\"\\u00");
+        p.write("41\"]");
+        p.finish();
+        BOOST_TEST(p.stats().suspensions_at(site::escape) == 1);
+        BOOST_TEST(p.stats().escapes == 1);
+        BOOST_TEST(p.stats().stack_reallocations == 1);
+
+        p.reset_stats();
+        BOOST_TEST(suspensions(p.stats()) == 0);
+        BOOST_TEST(p.stats().stack_reallocations == 0);
+    }
+
+    void
+    testCounters()
+    {
+        parser p;
+        p.write("[[{\"k\":\"a\\nb\\u0041\\ud83d\\ude00\"}],1.5]");
+        BOOST_TEST(suspensions(p.stats()) == 0);
+        BOOST_TEST(p.stats().escapes == 3);
+        BOOST_TEST(p.stats().max_depth == 3);
+        // numbers near the end of the
+        // buffer miss the fast path
+        BOOST_TEST(p.stats().slow_numbers == 1);
+
+        p.reset_stats();
+        p.reset();
+        p.write("[1.5                                  ]");
+        BOOST_TEST(p.stats().slow_numbers == 0);
+        BOOST_TEST(p.stats().max_depth == 1);
+
+        // counters accumulate over documents
+        p.reset();
+        p.write("[[2.5]]");
+        BOOST_TEST(p.stats().slow_numbers == 1);
+        BOOST_TEST(p.stats().max_depth == 2);
+    }
+
+    void
+    testComments()
+    {
+        parse_options opt;
+        opt.allow_comments = true;
+        stream_parser p(storage_ptr(), opt);
+        p.write("[1 /* comm");
+        p.write("ent */]");
+        p.finish();
+        BOOST_TEST(p.stats().suspensions_at(site::comment) == 1);
+        BOOST_TEST(p.stats().comment_parts == 1);
+    }
+#endif
+
+    void
+    run()
+    {
+        testDefault();
+    #ifdef BOOST_JSON_PARSER_STATS
+        testSuspensions();
+        testCounters();
+        testComments();
+    #endif
+    }
+};
+
+TEST_SUITE(parse_stats_test, "boost.json.parse_stats");
+
+BOOST_JSON_NS_END
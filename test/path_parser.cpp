@@ -0,0 +1,215 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/path_parser.hpp>
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <string>
+
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class path_parser_test
+{
+public:
+    ::test_suite::log_type log;
+
+    // feed `s` in two pieces split at every
+    // position, the results must equal the
+    // ones found by walking the parsed tree.
+    void
+    grind(
+        string_view path,
+        string_view s)
+    {
+        json_path const jp(path);
+        auto const expected =
+            serialize(jp.select(parse(s)));
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            error_code ec;
+            path_parser p(jp);
+            p.write_some(s.data(), i, ec);
+            if(! ec)
+                p.write(s.data() + i, s.size() - i, ec);
+            if(! ec)
+                p.finish(ec);
+            if(! BOOST_TEST(! ec))
+                return;
+            BOOST_TEST(p.done());
+            if(! BOOST_TEST(serialize(p.matches()) == expected))
+            {
+                log << "  " << path << " split at " << i << ": " <<
+                    serialize(p.matches()) << "\n";
+                return;
+            }
+        }
+    }
+
+    void
+    testMatches()
+    {
+        string_view const doc = R"({
+            "store": {
+                "book": [
+                    { "category": "reference", "author": "Rees",
+                      "title": "Sayings", "price": 8.95 },
+                    { "category": "fiction", "author": "Waugh",
+                      "title": "Sword", "price": 12.99 },
+                    { "category": "fiction", "author": "Melville",
+                      "title": "Moby Dick", "isbn": "0-553", "price": 8.99 },
+                    { "category": "fiction", "author": "Tolkien",
+                      "title": "The Lord", "isbn": "0-395", "price": 22.99 }
+                ],
+                "bicycle": { "color": "red", "price": 19.95,
+                    "gears": [1, -2, 3.5e10, true, false, null] },
+                "long key": 18446744073709551615
+            }
+        })";
+        grind("$", doc);
+        grind("$.store.bicycle.color", doc);
+        grind("$['store']['bicycle']", doc);
+        grind("$.store.book[*].author", doc);
+        grind("$..author", doc);
+        grind("$.store.*.price", doc);
+        grind("$..price", doc);
+        grind("$..book[2].title", doc);
+        grind("$..book[0:2].title", doc);
+        grind("$..book[1::2]", doc);
+        grind("$..isbn", doc);
+        grind("$..gears[*]", doc);
+        grind("$..['long key']", doc);
+        grind("$..*", doc);
+        grind("$..[0]", doc);
+        grind("$.store..price", doc);
+        grind("$..book..*", doc);
+        grind("$.nothing", doc);
+
+        grind("$..a", R"({"a":{"a":{"a":1}},"b":[{"a":2}]})");
+        grind("$..a.a", R"({"a":{"a":{"a":1}},"b":[{"a":2}]})");
+        grind("$[*][*]", "[[1,[2]],[],{\"x\":3},4]");
+        grind("$.*", "\"root\"");
+        grind("$", "12345");
+        grind("$", "\"a long string at the root\"");
+    }
+
+    void
+    testSplit()
+    {
+        // one character at a time
+        string_view const s =
+            R"({"key one":[12345,"value one",{"key one":67890}]})";
+        json_path const jp("$..['key one']");
+        path_parser p(jp);
+        error_code ec;
+        for(auto c : s)
+        {
+            p.write_some(&c, 1, ec);
+            if(! BOOST_TEST(! ec))
+                return;
+        }
+        p.finish(ec);
+        BOOST_TEST(! ec);
+        BOOST_TEST(serialize(p.matches()) ==
+            R"([[12345,"value one",{"key one":67890}],67890])");
+    }
+
+    void
+    testUsage()
+    {
+        // draining matches while parsing
+        {
+            path_parser p(json_path("$[*].id"));
+            p.write_some(R"([{"id":1},{"id":2},)");
+            BOOST_TEST(serialize(p.matches()) == "[1,2]");
+            p.matches().clear();
+            p.write_some(R"({"id":3}])");
+            p.finish();
+            BOOST_TEST(serialize(p.matches()) == "[3]");
+        }
+
+        // reset keeps the matches
+        {
+            path_parser p(json_path("$.a"));
+            p.write(R"({"a":1})");
+            p.finish();
+            p.reset();
+            p.write(R"({"b":1,"a":2})");
+            p.finish();
+            BOOST_TEST(serialize(p.matches()) == "[1,2]");
+        }
+
+        // memory resource
+        {
+            monotonic_resource mr;
+            path_parser p(json_path("$.a"), &mr);
+            p.write(R"({"a":[1,2,3]})");
+            p.finish();
+            BOOST_TEST(*p.matches().storage() == mr);
+            BOOST_TEST(*p.matches()[0].storage() == mr);
+        }
+
+        // parse options
+        {
+            parse_options opt;
+            opt.allow_comments = true;
+            opt.allow_trailing_commas = true;
+            path_parser p(json_path("$.a"), {}, opt);
+            p.write(R"(/*c*/{"a":[1,2,],})");
+            p.finish();
+            BOOST_TEST(serialize(p.matches()) == "[[1,2]]");
+        }
+
+        // errors
+        {
+            path_parser p(json_path("$.a"));
+            error_code ec;
+            p.write(R"({"a":1} x)", ec);
+            BOOST_TEST(ec == error::extra_data);
+        }
+        {
+            path_parser p(json_path("$.a"));
+            error_code ec;
+            p.write(R"({"b":[1,2})", ec);
+            BOOST_TEST(ec == error::syntax);
+            BOOST_TEST(p.matches().empty());
+        }
+        {
+            path_parser p(json_path("$.a"));
+            p.write(R"({"a":)");
+            BOOST_TEST_THROWS(p.finish(), system_error);
+        }
+        {
+            path_parser p(json_path("$.a"));
+            BOOST_TEST_THROWS(p.write("]"), system_error);
+        }
+        {
+            path_parser p(json_path("$.a"));
+            BOOST_TEST_THROWS(p.write_some("]"), system_error);
+        }
+    }
+
+    void
+    run()
+    {
+        testMatches();
+        testSplit();
+        testUsage();
+    }
+};
+
+TEST_SUITE(path_parser_test, "boost.json.path_parser");
+
+BOOST_JSON_NS_END
@@ -0,0 +1,208 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/schema_parser.hpp>
+
+#include <boost/json/monotonic_resource.hpp>
+#include <boost/json/parse.hpp>
+#include <boost/json/serialize.hpp>
+
+#include <string>
+
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class schema_parser_test
+{
+public:
+    ::test_suite::log_type log;
+
+    // feed `s` in two pieces split at every
+    // position, the result must equal the one
+    // found by checking the parsed value.
+    void
+    grind(
+        json_schema const& js,
+        string_view s)
+    {
+        value const jv = parse(s);
+        error_code expected;
+        js.validate(jv, expected);
+        for(std::size_t i = 0; i <= s.size(); ++i)
+        {
+            error_code ec;
+            schema_parser p(js);
+            p.write_some(s.data(), i, ec);
+            if(! ec)
+                p.write(s.data() + i, s.size() - i, ec);
+            if(! ec)
+                p.finish(ec);
+            if(! BOOST_TEST(ec == expected))
+            {
+                log << "  " << s << " split at " << i << ": " <<
+                    ec.message() << "\n";
+                return;
+            }
+            if(ec)
+            {
+                BOOST_TEST(! p.done());
+                BOOST_TEST_THROWS(p.release(), system_error);
+                continue;
+            }
+            BOOST_TEST(p.done());
+            BOOST_TEST(p.release() == jv);
+        }
+    }
+
+    void
+    testGrind()
+    {
+        json_schema const js(parse(R"({
+            "type": "object",
+            "properties": {
+                "id": { "type": "integer", "minimum": 1 },
+                "a long property name": {
+                    "type": "string", "minLength": 2, "maxLength": 6 },
+                "tags": { "type": "array", "maxItems": 3,
+                    "items": { "type": ["string", "null"] } },
+                "any": true,
+                "nested": { "additionalProperties": { "type": "number" } }
+            },
+            "required": ["id", "a long property name"],
+            "additionalProperties": false
+        })"));
+        grind(js, R"({"id":1,"a long property name":"abc"})");
+        grind(js, R"({"a long property name":"abc","id":1,"tags":["x",null]})");
+        grind(js, R"({"id":1,"a long property name":"é€é€"})");
+        grind(js, R"({"id":1,"a long property name":"abc","any":[{"x":[1,"y"]}]})");
+        grind(js, R"({"id":1,"a long property name":"ab","nested":{"p":1.5,"q":-2}})");
+        grind(js, R"({"id":1})");
+        grind(js, R"({"id":0,"a long property name":"abc"})");
+        grind(js, R"({"id":1.5,"a long property name":"abc"})");
+        grind(js, R"({"id":1,"a long property name":"a"})");
+        grind(js, R"({"id":1,"a long property name":"abcdefg"})");
+        grind(js, R"({"id":1,"a long property name":"abc","tags":[1]})");
+        grind(js, R"({"id":1,"a long property name":"abc","tags":[null,null,null,null]})");
+        grind(js, R"({"id":1,"a long property name":"abc","nested":{"p":"1"}})");
+        grind(js, R"({"id":1,"a long property name":"abc","extra":1})");
+        grind(js, R"({"an extra property name":1,"id":1})");
+        grind(js, R"([])");
+        grind(js, R"("a string at the root")");
+        grind(js, R"(12345)");
+
+        json_schema const js2(parse(R"({"items":{"minimum":-1,"maximum":1}})"));
+        grind(js2, "[0,1,-1,0.5,-0.5,true,\"s\",{},[]]");
+        grind(js2, "[0,1,-1,2]");
+        grind(js2, "[0,1,-1,-1.5]");
+        grind(js2, "[0,18446744073709551615]");
+    }
+
+    void
+    testEarly()
+    {
+        // the parse stops at the violation
+        json_schema const js(parse(R"({"items":{"type":"integer"}})"));
+        schema_parser p(js);
+        error_code ec;
+        string_view const s = "[1,2,\"x\",3,4,5]";
+        auto const n = p.write_some(s, ec);
+        BOOST_TEST(ec == error::type_mismatch);
+        BOOST_TEST(ec == condition::schema_error);
+        BOOST_TEST(n < s.size());
+        BOOST_TEST_THROWS(p.write("]"), system_error);
+        BOOST_TEST_THROWS(p.finish(), system_error);
+
+        // a long string is rejected before it ends
+        json_schema const js2(parse(R"({"maxLength":4})"));
+        schema_parser p2(js2);
+        p2.write_some("\"abc", ec);
+        BOOST_TEST(! ec);
+        p2.write_some("defgh", ec);
+        BOOST_TEST(ec == error::size_out_of_range);
+
+        // so is an unknown key
+        json_schema const js3(parse(R"({"additionalProperties":false})"));
+        schema_parser p3(js3);
+        p3.write_some(R"({"a":)", ec);
+        BOOST_TEST(ec == error::additional_property);
+    }
+
+    void
+    testUsage()
+    {
+        json_schema const js(parse(R"({"type":"array","items":{"type":"string"}})"));
+
+        // reset after an error
+        {
+            schema_parser p(js);
+            error_code ec;
+            p.write("[1]", ec);
+            BOOST_TEST(ec == error::type_mismatch);
+            p.reset();
+            p.write(R"(["a","b"])");
+            BOOST_TEST(serialize(p.release()) == R"(["a","b"])");
+            p.reset();
+            p.write(R"([)");
+            p.write_some(R"("c"])");
+            BOOST_TEST(serialize(p.release()) == R"(["c"])");
+        }
+
+        // memory resource
+        {
+            monotonic_resource mr;
+            schema_parser p(js);
+            p.reset(&mr);
+            p.write(R"(["a"])");
+            value const jv = p.release();
+            BOOST_TEST(*jv.storage() == mr);
+        }
+
+        // parse options
+        {
+            parse_options opt;
+            opt.allow_comments = true;
+            opt.allow_trailing_commas = true;
+            schema_parser p(js, {}, opt);
+            p.write(R"(/*c*/["a",])");
+            BOOST_TEST(serialize(p.release()) == R"(["a"])");
+        }
+
+        // parse errors
+        {
+            schema_parser p(js);
+            error_code ec;
+            p.write(R"(["a"] x)", ec);
+            BOOST_TEST(ec == error::extra_data);
+        }
+        {
+            schema_parser p(js);
+            p.write(R"(["a")");
+            BOOST_TEST_THROWS(p.finish(), system_error);
+        }
+        {
+            schema_parser p(js);
+            BOOST_TEST_THROWS(p.write_some("[1,"), system_error);
+        }
+    }
+
+    void
+    run()
+    {
+        testGrind();
+        testEarly();
+        testUsage();
+    }
+};
+
+TEST_SUITE(schema_parser_test, "boost.json.schema_parser");
+
+BOOST_JSON_NS_END
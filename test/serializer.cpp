@@ -13,6 +13,8 @@
 #include <boost/json/parse.hpp>
 #include <boost/json/serialize.hpp>
 #include <iostream>
+#include <limits>
+#include <string>
 
 #include "parse-vectors.hpp"
 #include "test.hpp"
@@ -543,6 +545,181 @@ public:
         BOOST_TEST(serialize(parse("-0.0")) == "-0E0");
     }
 
+    void
+    testDeepNesting()
+    {
+        // every read suspends with the whole
+        // depth of the value on the stack
+        std::size_t const depth = 2000;
+        std::string js(depth, '[');
+        js.append(depth, ']');
+        parse_options opt;
+        opt.max_depth = depth;
+        auto const jv = parse(js, {}, opt);
+        serializer sr;
+        sr.reset(&jv);
+        std::string s;
+        char buf[64];
+        while(! sr.done())
+        {
+            auto const sv = sr.read(buf);
+            s.append(sv.data(), sv.size());
+        }
+        BOOST_TEST(s == js);
+    }
+
+    std::string
+    canonical(value const& jv, std::size_t size)
+    {
+        serialize_options opts;
+        opts.canonical = true;
+        serializer sr(opts);
+        BOOST_TEST(sr.options().canonical);
+        sr.reset(&jv);
+        std::string s;
+        char buf[64];
+        BOOST_ASSERT(size <= sizeof(buf));
+        while(! sr.done())
+        {
+            auto const sv = sr.read(buf, size);
+            s.append(sv.data(), sv.size());
+        }
+        return s;
+    }
+
+    void
+    checkCanonical(
+        string_view js,
+        string_view expected)
+    {
+        auto const jv = parse(js);
+        serialize_options opts;
+        opts.canonical = true;
+        BOOST_TEST(serialize(jv, opts) == expected);
+        // every suspension point
+        for(std::size_t i = 1; i <= 7; ++i)
+            BOOST_TEST(canonical(jv, i) == expected);
+    }
+
+    void
+    checkCanonicalValue(
+        value const& jv,
+        string_view expected)
+    {
+        serialize_options opts;
+        opts.canonical = true;
+        BOOST_TEST(serialize(jv, opts) == expected);
+        BOOST_TEST(canonical(jv, 1) == expected);
+    }
+
+    void
+    testCanonical()
+    {
+        // RFC 8785 section 3.2.2
+        checkCanonical(
+            "{\"numbers\":[333333333.33333329,1E30,4.50,"
+                "2e-3,0.000000000000000000000000001],"
+            "\"string\":\"\\u20ac$\\u000F\\u000aA'\\u0042"
+                "\\u0022\\u005c\\\\\\\"\\/\","
+            "\"literals\":[null,true,false]}",
+            "{\"literals\":[null,true,false],"
+            "\"numbers\":[333333333.3333333,1e+30,4.5,"
+                "0.002,1e-27],"
+            "\"string\":\"\xe2\x82\xac$\\u000f\\nA'B"
+                "\\\"\\\\\\\\\\\"/\"}");
+
+        // RFC 8785 section 3.2.3, keys above
+        // U+FFFF sort before U+E000 to U+FFFF
+        checkCanonical(
+            "{\"\\u20ac\":1,\"\\r\":2,\"\\ufb33\":3,\"1\":4,"
+            "\"\\ud83d\\ude00\":5,\"\\u0080\":6,\"\\u00f6\":7}",
+            "{\"\\r\":2,\"1\":4,\"\xc2\x80\":6,\"\xc3\xb6\":7,"
+            "\"\xe2\x82\xac\":1,\"\xf0\x9f\x98\x80\":5,"
+            "\"\xef\xac\xb3\":3}");
+
+        // prefixes sort first
+        checkCanonical(
+            "{\"ab\":1,\"a\":2,\"\":3,\"b\":4}",
+            "{\"\":3,\"a\":2,\"ab\":1,\"b\":4}");
+
+        // nested objects, at every suspension
+        checkCanonical(
+            "[{\"z\":{\"y\":{},\"x\":[{\"w\":1,\"v\":2}]},"
+            "\"a\":{\"c\":3,\"b\":{\"e\":null,\"d\":\"s\"}}},{}]",
+            "[{\"a\":{\"b\":{\"d\":\"s\",\"e\":null},\"c\":3},"
+            "\"z\":{\"x\":[{\"v\":2,\"w\":1}],\"y\":{}}},{}]");
+
+        // numbers
+        checkCanonical("0", "0");
+        checkCanonical("-0", "0");
+        checkCanonical("-0.0", "0");
+        checkCanonical("1.0", "1");
+        checkCanonical("-1.5e-9", "-1.5e-9");
+        checkCanonical("5e-324", "5e-324");
+        checkCanonical("1.7976931348623157e308",
+            "1.7976931348623157e+308");
+        checkCanonical("1e21", "1e+21");
+        checkCanonical("1e20", "100000000000000000000");
+        checkCanonical("123e18", "123000000000000000000");
+        checkCanonical("295147905179352830000",
+            "295147905179352830000");
+        checkCanonical("0.000001", "0.000001");
+        checkCanonical("1e-7", "1e-7");
+        checkCanonical("1.2345e25", "1.2345e+25");
+        checkCanonical("12.5", "12.5");
+        checkCanonical("-9007199254740992",
+            "-9007199254740992");
+        checkCanonical("9007199254740993",
+            "9007199254740992");
+        checkCanonical("9223372036854775807",
+            "9223372036854776000");
+        checkCanonical("-9223372036854775808",
+            "-9223372036854776000");
+        checkCanonical("18446744073709551615",
+            "18446744073709552000");
+        checkCanonicalValue(value(
+            std::numeric_limits<double>::infinity()),
+            "null");
+        checkCanonicalValue(value(
+            std::numeric_limits<double>::quiet_NaN()),
+            "null");
+
+        // objects given directly
+        {
+            object const obj = {{"b", 1}, {"a", 2}};
+            serialize_options opts;
+            opts.canonical = true;
+            BOOST_TEST(serialize(obj, opts) ==
+                "{\"a\":2,\"b\":1}");
+            BOOST_TEST(serialize(obj) ==
+                "{\"b\":1,\"a\":2}");
+            array const arr = {obj, 1.0};
+            BOOST_TEST(serialize(arr, opts) ==
+                "[{\"a\":2,\"b\":1},1]");
+        }
+
+        // reset during an object
+        {
+            auto const jv = parse(
+                "{\"b\":{\"d\":1,\"c\":2},\"a\":3}");
+            serialize_options opts;
+            opts.canonical = true;
+            serializer sr(opts);
+            sr.reset(&jv);
+            char buf[8];
+            sr.read(buf);
+            sr.reset(&jv);
+            std::string s;
+            while(! sr.done())
+            {
+                auto const sv = sr.read(buf);
+                s.append(sv.data(), sv.size());
+            }
+            BOOST_TEST(s ==
+                "{\"a\":3,\"b\":{\"c\":2,\"d\":1}}");
+        }
+    }
+
     void
     run()
     {
@@ -557,6 +734,8 @@ public:
         testVectors();
         testOstream();
         testNumberRoundTrips();
+        testDeepNesting();
+        testCanonical();
     }
 };
 
@@ -250,6 +250,21 @@ usingValues()
         // a null pointer is never dereferenced.
         *jv.if_string() = "Hello, world!";
 
+        //]
+    }
+    {
+        //[snippet_value_9
+
+        std::unordered_map< value, std::string > cache;
+
+        cache[ parse( R"({"id":1,"tags":["a","b"]})" ) ] = "first";
+
+        // Objects with the same members in a different order are equal
+        assert( cache.at( parse( R"({"tags":["a","b"],"id":1})" ) ) == "first" );
+
+        // Arrays are equal only with the same elements in the same order
+        assert( cache.count( parse( R"({"id":1,"tags":["b","a"]})" ) ) == 0 );
+
         //]
     }
 }
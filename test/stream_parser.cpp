@@ -17,6 +17,8 @@
 
 #include <sstream>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "parse-vectors.hpp"
 #include "test.hpp"
@@ -208,6 +210,48 @@ public:
             }
         }
 
+        // write(ConstBufferSequence const&, error_code&)
+        {
+            {
+                stream_parser p;
+                error_code ec;
+                std::vector<string_view> v{
+                    "[1,", "23", "4,5]"};
+                BOOST_TEST(p.write(v, ec) == 9);
+                BOOST_TEST(! ec);
+                BOOST_TEST(serialize(
+                    p.release()) == "[1,234,5]");
+            }
+            {
+                stream_parser p;
+                error_code ec;
+                std::vector<string_view> v{
+                    "[]", "*"};
+                p.write(v, ec);
+                BOOST_TEST(
+                    ec == error::extra_data);
+            }
+        }
+
+        // write(ConstBufferSequence const&)
+        {
+            {
+                stream_parser p;
+                std::vector<std::vector<char>> v{
+                    {'t', 'r'}, {}, {'u', 'e'}};
+                BOOST_TEST(p.write(v) == 4);
+                BOOST_TEST(p.release() == true);
+            }
+            {
+                stream_parser p;
+                std::vector<std::string> v{
+                    "[1", ",*"};
+                BOOST_TEST_THROWS(
+                    p.write(v),
+                    system_error);
+            }
+        }
+
         // finish(error_code&)
         // finish()
         {
@@ -514,6 +558,31 @@ public:
         grind("\"\\ud800\\udc00\"");
         grind("\"\\udbff\\udffF\"");
 
+        // unescaped runs between escapes
+        grind("\"abc\\ndef\\u00e9ghi\\ud83d\\ude00jkl\\\\\"",
+            [](value const& jv, const parse_options&)
+            {
+                BOOST_TEST(jv.as_string() ==
+                    "abc\ndef\xc3\xa9ghi\xf0\x9f\x98\x80jkl\\");
+            });
+
+        // escaped string larger than the temporary buffer
+        {
+            std::string js = "\"";
+            std::string s;
+            for(int i = 0; i < 200; ++i)
+            {
+                js += "0123456789\\t\xc3\xa9\\u00e9";
+                s += "0123456789\t\xc3\xa9\xc3\xa9";
+            }
+            js += "\"";
+            grind(js,
+                [&s](value const& jv, const parse_options&)
+                {
+                    BOOST_TEST(jv.as_string() == s);
+                });
+        }
+
         // big string
         {
             std::string const big(4000, '*');
@@ -1046,6 +1115,84 @@ R"xx({
             BOOST_TEST(serialize(p.release()) == out);
     }
 
+    // parse `s` as a sequence of segments
+    // whose sizes are taken in turn from `sizes`
+    void
+    check_segments(
+        string_view s,
+        std::vector<std::size_t> const& sizes)
+    {
+        std::vector<string_view> v;
+        for(std::size_t i = 0, j = 0;
+            i < s.size(); ++j)
+        {
+            auto const n = (std::min)(
+                sizes[j % sizes.size()],
+                s.size() - i);
+            v.push_back(s.substr(i, n));
+            i += n;
+        }
+        stream_parser p;
+        error_code ec;
+        BOOST_TEST(p.write(v, ec) == s.size());
+        if(BOOST_TEST(! ec))
+            p.finish(ec);
+        if(BOOST_TEST(! ec))
+            BOOST_TEST(p.release() == parse(s));
+    }
+
+    void
+    testBufferSequence()
+    {
+        // every split into three segments
+        {
+            string_view const s =
+                R"({"a":[1,-2.5e3,"x\u00e9y"],"bc":true})";
+            for(std::size_t i = 0; i <= s.size(); ++i)
+            for(std::size_t j = i; j <= s.size(); ++j)
+            {
+                std::vector<string_view> v{
+                    s.substr(0, i),
+                    s.substr(i, j - i),
+                    s.substr(j)};
+                stream_parser p;
+                error_code ec;
+                p.write(v, ec);
+                if(! BOOST_TEST(! ec))
+                {
+                    log << "split at " << i << ", " << j << "\n";
+                    return;
+                }
+                BOOST_TEST(p.release() == parse(s));
+            }
+        }
+
+        // segments smaller and larger
+        // than the gather buffer
+        {
+            std::string s = "[";
+            for(int i = 0; i < 500; ++i)
+            {
+                if(i > 0)
+                    s += ",\n";
+                s += R"({"id":)" + std::to_string(i * 7919) +
+                    R"(,"name":"item number )" + std::to_string(i) +
+                    R"(","ratio":0.)" + std::to_string(i * 31) +
+                    R"(,"flags":[true,false,null]})";
+            }
+            s += "]";
+            check_segments(s, {1});
+            check_segments(s, {3, 1, 4, 1, 5, 9, 2, 6});
+            check_segments(s, {17, 250, 3000});
+            check_segments(s, {5000, 7});
+            check_segments(s, {s.size()});
+
+            // a string longer than the buffer
+            check_segments("[\"" + std::string(10000, 'x') +
+                "\",1]", {4000, 2, 6000});
+        }
+    }
+
     void 
     testTrailingCommas()
     {
@@ -1215,6 +1362,7 @@ R"xx({
 
         testFreeFunctions();
         testSampleJson();
+        testBufferSequence();
         testUnicodeStrings();
         testTrailingCommas();
         testComments();
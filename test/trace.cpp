@@ -0,0 +1,166 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/trace.hpp>
+
+#include <boost/json/parser.hpp>
+#include <boost/json/serializer.hpp>
+#include <boost/json/stream_parser.hpp>
+
+#include <vector>
+
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+/*
+    The hooks are only called when the library is
+    built with BOOST_JSON_TRACE, which is done by
+    a separate test target.
+*/
+
+class trace_test
+{
+public:
+    struct record
+    {
+        bool begin;
+        trace_event ev;
+        std::size_t n;
+    };
+
+    class recorder : public trace_hooks
+    {
+    public:
+        std::vector<record> v;
+
+        void
+        on_begin(
+            trace_event ev,
+            std::size_t n) noexcept override
+        {
+            v.push_back({ true, ev, n });
+        }
+
+        void
+        on_end(
+            trace_event ev,
+            std::size_t n) noexcept override
+        {
+            v.push_back({ false, ev, n });
+        }
+    };
+
+    static
+    bool
+    is(
+        record const& r,
+        bool begin,
+        trace_event ev,
+        std::size_t n)
+    {
+        return r.begin == begin && r.ev == ev && r.n == n;
+    }
+
+    void
+    testHooks()
+    {
+        recorder r;
+        r.on_begin(trace_event::parse, 1);
+        r.on_end(trace_event::parse, 1);
+        BOOST_TEST(r.v.size() == 2);
+    }
+
+#ifdef BOOST_JSON_TRACE
+    void
+    testParser()
+    {
+        recorder r;
+        BOOST_TEST(set_trace_hooks(&r) == nullptr);
+        BOOST_TEST(get_trace_hooks() == &r);
+        parser p;
+        p.write("[1,{\"a\":2}] ");
+        set_trace_hooks(nullptr);
+        if(! BOOST_TEST(r.v.size() == 6))
+            return;
+        BOOST_TEST(is(r.v[0], true, trace_event::parse, 12));
+        // the object completes before the array
+        BOOST_TEST(is(r.v[1], true, trace_event::build_object, 1));
+        BOOST_TEST(is(r.v[2], false, trace_event::build_object, 1));
+        BOOST_TEST(is(r.v[3], true, trace_event::build_array, 2));
+        BOOST_TEST(is(r.v[4], false, trace_event::build_array, 2));
+        BOOST_TEST(is(r.v[5], false, trace_event::parse, 12));
+    }
+
+    void
+    testStreamParser()
+    {
+        recorder r;
+        set_trace_hooks(&r);
+        stream_parser p;
+        p.write("[1,");
+        p.write("2]");
+        p.finish();
+        set_trace_hooks(nullptr);
+        if(! BOOST_TEST(r.v.size() == 8))
+            return;
+        BOOST_TEST(is(r.v[0], true, trace_event::parse, 3));
+        BOOST_TEST(is(r.v[1], false, trace_event::parse, 3));
+        BOOST_TEST(is(r.v[2], true, trace_event::parse, 2));
+        BOOST_TEST(is(r.v[3], true, trace_event::build_array, 2));
+        BOOST_TEST(is(r.v[5], false, trace_event::parse, 2));
+        BOOST_TEST(is(r.v[6], true, trace_event::finish, 0));
+        BOOST_TEST(is(r.v[7], false, trace_event::finish, 0));
+
+        // errors end the operation as well
+        r.v.clear();
+        set_trace_hooks(&r);
+        p.reset();
+        BOOST_TEST_THROWS(p.write("]"), system_error);
+        set_trace_hooks(nullptr);
+        if(BOOST_TEST(r.v.size() == 2))
+            BOOST_TEST(is(r.v[1], false, trace_event::parse, 0));
+    }
+
+    void
+    testSerializer()
+    {
+        value const jv = { 1, 2, 3 };
+        recorder r;
+        set_trace_hooks(&r);
+        serializer sr;
+        sr.reset(&jv);
+        char buf[4];
+        sr.read(buf);
+        sr.read(buf);
+        set_trace_hooks(nullptr);
+        if(! BOOST_TEST(r.v.size() == 4))
+            return;
+        BOOST_TEST(is(r.v[0], true, trace_event::serialize, 4));
+        BOOST_TEST(is(r.v[1], false, trace_event::serialize, 4));
+        BOOST_TEST(is(r.v[3], false, trace_event::serialize, 3));
+    }
+#endif
+
+    void
+    run()
+    {
+        testHooks();
+    #ifdef BOOST_JSON_TRACE
+        testParser();
+        testStreamParser();
+        testSerializer();
+    #endif
+    }
+};
+
+TEST_SUITE(trace_test, "boost.json.trace");
+
+BOOST_JSON_NS_END
@@ -0,0 +1,204 @@
+//
+// Copyright (c) 2019 Vinnie Falco (vinnie.falco@gmail.com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Official repository: https://github.com/boostorg/json
+//
+
+// Test that header file is self-contained.
+#include <boost/json/validate.hpp>
+
+#include <boost/json/parser.hpp>
+
+#include <string>
+
+#include "parse-vectors.hpp"
+#include "test.hpp"
+#include "test_suite.hpp"
+
+BOOST_JSON_NS_BEGIN
+
+class validate_test
+{
+public:
+    ::test_suite::log_type log;
+
+    static
+    parse_options
+    make_options(
+        bool comments,
+        bool commas,
+        bool utf8)
+    {
+        parse_options opt;
+        opt.allow_comments = comments;
+        opt.allow_trailing_commas = commas;
+        opt.allow_invalid_utf8 = utf8;
+        return opt;
+    }
+
+    void
+    good(
+        string_view s,
+        parse_options const& opt = {})
+    {
+        error_code ec;
+        auto const n = validate(s, ec, opt);
+        BOOST_TEST(! ec);
+        BOOST_TEST(n == s.size());
+        BOOST_TEST(validate(s, opt));
+    }
+
+    void
+    bad(
+        string_view s,
+        error e,
+        std::size_t offset,
+        parse_options const& opt = {})
+    {
+        error_code ec;
+        auto const n = validate(s, ec, opt);
+        BOOST_TEST(ec == e);
+        BOOST_TEST(n == offset);
+        BOOST_TEST(! validate(s, opt));
+    }
+
+    void
+    testValidate()
+    {
+        good("null");
+        good("true");
+        good("false");
+        good(" [1,2,3] ");
+        good("-0.5e+10");
+        good(R"({"a":[{},[],"\u00e9\ud834\udd1e"]})");
+        good("\"\xe6\x97\xa5\xc3\xa9\"");
+
+        bad("",            error::incomplete, 0);
+        bad("   ",         error::incomplete, 3);
+        bad("nul",         error::incomplete, 3);
+        bad("nulp",        error::syntax, 0);
+        bad("[1,2,3] #",   error::extra_data, 8);
+        bad("[1,2,]",      error::syntax, 5);
+        bad("[1 2]",       error::syntax, 3);
+        bad("{\"a\" 1}",   error::syntax, 5);
+        bad("{1:2}",       error::syntax, 1);
+        bad("01",          error::extra_data, 1);
+        bad("1.",          error::incomplete, 2);
+        bad("1.e",         error::syntax, 2);
+        bad("1e",          error::incomplete, 2);
+        bad("1e99999999999", error::exponent_overflow, 11);
+        bad("\"abc",       error::incomplete, 4);
+        bad("\"\x01\"",    error::syntax, 1);
+        bad("\"\\x\"",     error::syntax, 2);
+        bad("\"\\u12g4\"", error::expected_hex_digit, 5);
+        bad("\"\\udc00\"", error::illegal_leading_surrogate, 2);
+        bad("\"\\ud800\\u0041\"",
+            error::illegal_trailing_surrogate, 9);
+        bad("\"\xff\"",    error::syntax, 1);
+        bad("\"\xe6\x97",  error::incomplete, 1);
+
+        // extensions
+        good("[1,2,]", make_options(false, true, false));
+        good(R"({"a":1,})", make_options(false, true, false));
+        good("/* c */ [1, // c\n 2] // c",
+            make_options(true, false, false));
+        bad ("[1 /* c",    error::incomplete, 7,
+            make_options(true, false, false));
+        bad ("[1 /x]",     error::syntax, 4,
+            make_options(true, false, false));
+        good("\"\xff\"",   make_options(false, false, true));
+
+        // max_depth
+        {
+            parse_options opt;
+            opt.max_depth = 2;
+            good("[[]]", opt);
+            good("[{}]", opt);
+            bad ("[[[]]]", error::too_deep, 2, opt);
+            bad ("{\"a\":{\"b\":{}}}", error::too_deep, 10, opt);
+        }
+
+        // deep nesting does not recurse
+        {
+            parse_options opt;
+            opt.max_depth = std::size_t(-1);
+            std::string s;
+            for(int i = 0; i < 65536; ++i)
+                s += i % 2 ? "{\"\":" : "[";
+            s += "0";
+            for(int i = 65536; i--;)
+                s += i % 2 ? "}" : "]";
+            good(s, opt);
+            s.insert(s.begin(), '[');
+            s.push_back(']');
+            bad (s, error::too_deep, s.rfind('{'), opt);
+            bad (std::string(1000000, '['),
+                error::too_deep, 65536, opt);
+            bad (std::string(1000, '['),
+                error::incomplete, 1000, opt);
+        }
+    }
+
+    // validate must agree with parser on
+    // every vector, in every configuration
+    void
+    testVectors()
+    {
+        std::vector<parse_options> all_configs =
+        {
+            make_options(false, false, true),
+            make_options(true, false, true),
+            make_options(false, true, true),
+            make_options(true, true, true),
+            make_options(false, false, false),
+            make_options(true, false, false),
+            make_options(false, true, false),
+            make_options(true, true, false)
+        };
+        parse_vectors pv;
+        for(auto const& v : pv)
+        {
+            for(parse_options const& po : all_configs)
+            {
+                error_code ec0;
+                parser p({}, po);
+                auto const n0 = p.write(
+                    v.text.data(), v.text.size(), ec0);
+
+                error_code ec1;
+                auto const n1 = validate(v.text, ec1, po);
+                BOOST_TEST(! ec1 == ! ec0);
+                // the incremental path of basic_parser
+                // reports a lone trailing surrogate
+                // with a different error
+                if( ec0 == error::illegal_leading_surrogate ||
+                    ec0 == error::illegal_trailing_surrogate)
+                    continue;
+                if(! BOOST_TEST(ec1 == ec0) ||
+                    ! BOOST_TEST(n1 == n0))
+                    log << "  " << v.name << "\n";
+                if(v.result == 'y')
+                    BOOST_TEST(! ec1);
+                else if(v.result == 'n' &&
+                    ! po.allow_comments &&
+                    ! po.allow_trailing_commas &&
+                    ! po.allow_invalid_utf8)
+                    BOOST_TEST(ec1);
+            }
+        }
+    }
+
+    void
+    run()
+    {
+        testValidate();
+        testVectors();
+    }
+};
+
+TEST_SUITE(validate_test, "boost.json.validate");
+
+BOOST_JSON_NS_END
@@ -14,6 +14,7 @@
 
 #include <memory>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "test.hpp"
@@ -2089,6 +2090,68 @@ public:
 
     //------------------------------------------------------
 
+    static
+    std::size_t
+    hash(value const& jv)
+    {
+        return std::hash<value>()(jv);
+    }
+
+    void
+    testHash()
+    {
+        // equal values hash equally
+        BOOST_TEST(hash(value(1)) == hash(value(1UL)));
+        BOOST_TEST(hash(value(0.0)) == hash(value(-0.0)));
+        BOOST_TEST(hash(value({
+            {"a",1}, {"b",{1,2}}, {"c",{{"d",nullptr}}} })) ==
+            hash(value({
+            {"c",{{"d",nullptr}}}, {"a",1}, {"b",{1,2}} })));
+        BOOST_TEST(hash(value({"abc", 1.5})) ==
+            std::hash<array>()(array({"abc", 1.5})));
+        BOOST_TEST(hash(value({{"a",1}})) ==
+            std::hash<object>()(object({{"a",1}})));
+
+        // distinguishable values
+        BOOST_TEST(hash(value(nullptr)) != hash(value(false)));
+        BOOST_TEST(hash(value(false)) != hash(value(true)));
+        BOOST_TEST(hash(value(false)) != hash(value(0)));
+        BOOST_TEST(hash(value(0)) != hash(value(0.0)));
+        BOOST_TEST(hash(value(2.0)) != hash(value(2)));
+        BOOST_TEST(hash(value("")) != hash(value(array())));
+        BOOST_TEST(hash(value(array())) != hash(value(object())));
+        BOOST_TEST(hash(value({1,2,3})) != hash(value({2,3,1})));
+        BOOST_TEST(hash(value({1,2})) != hash(value({{1,2}})));
+        BOOST_TEST(hash(value({{"a","b"}})) != hash(value({{"b","a"}})));
+        BOOST_TEST(hash(value({
+            {"a",1}, {"b",2} })) != hash(value({
+            {"a",2}, {"b",1} })));
+
+        // salt
+        {
+            std::hash<value> h1(32);
+            std::hash<value> h2(h1);
+            std::hash<value> h3(59);
+            value const jv = {1, 2, 3};
+            BOOST_TEST(h1(jv) == h2(jv));
+            BOOST_TEST(h1(jv) != h3(jv));
+            h1 = h3;
+            BOOST_TEST(h1(jv) == h3(jv));
+        }
+
+        // as a key
+        {
+            std::unordered_set<value> us;
+            us.emplace(value({{"x",1}, {"y",2}}));
+            us.emplace(value({{"y",2}, {"x",1}}));
+            us.emplace(value({1, 2}));
+            us.emplace(value({2, 1}));
+            BOOST_TEST(us.size() == 3);
+        }
+    }
+
+    //------------------------------------------------------
+
     void
     run()
     {
@@ -2108,6 +2171,7 @@ public:
         testStdConstruction();
         testInitList();
         testEquality();
+        testHash();
     }
 };
 